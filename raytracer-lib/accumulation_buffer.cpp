@@ -0,0 +1,72 @@
+//
+//  accumulation_buffer.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "accumulation_buffer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace rtlib;
+
+AccumulationBuffer::AccumulationBuffer(PixelIndex width, PixelIndex height) :
+    _width(width),
+    _height(height),
+    _sums(width * height * 3, 0.0f),
+    _samples(width * height, 0)
+{
+}
+
+AccumulationBuffer::PixelIndex AccumulationBuffer::width() const {
+    return _width;
+}
+
+AccumulationBuffer::PixelIndex AccumulationBuffer::height() const {
+    return _height;
+}
+
+void AccumulationBuffer::addSample(PixelIndex x, PixelIndex y, const Colour& colour) {
+    if (x >= _width || y >= _height) {
+        throw std::runtime_error("Pixel index is out of bounds.");
+    }
+    
+    auto index = y * _width + x;
+    _sums[index * 3] += static_cast<float>(colour.red());
+    _sums[index * 3 + 1] += static_cast<float>(colour.green());
+    _sums[index * 3 + 2] += static_cast<float>(colour.blue());
+    _samples[index]++;
+}
+
+unsigned int AccumulationBuffer::sampleCount(PixelIndex x, PixelIndex y) const {
+    return _samples[y * _width + x];
+}
+
+Colour AccumulationBuffer::average(PixelIndex x, PixelIndex y) const {
+    auto index = y * _width + x;
+    if (_samples[index] == 0) {
+        return Colour();
+    }
+    
+    auto samples = static_cast<double>(_samples[index]);
+    return Colour(_sums[index * 3] / samples, _sums[index * 3 + 1] / samples, _sums[index * 3 + 2] / samples);
+}
+
+void AccumulationBuffer::resolve(Canvas& canvas) const {
+    if (canvas.width() != _width || canvas.height() != _height) {
+        throw std::runtime_error("Canvas size doesn't match the accumulation buffer.");
+    }
+    
+    for (PixelIndex y = 0; y < _height; y++) {
+        for (PixelIndex x = 0; x < _width; x++) {
+            canvas.writePixel(x, y, average(x, y));
+        }
+    }
+}
+
+void AccumulationBuffer::clear() {
+    std::fill(_sums.begin(), _sums.end(), 0.0f);
+    std::fill(_samples.begin(), _samples.end(), 0);
+}
@@ -0,0 +1,46 @@
+//
+//  accumulation_buffer.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef accumulation_buffer_hpp
+#define accumulation_buffer_hpp
+
+#include "canvas.hpp"
+#include "colour.hpp"
+
+#include <vector>
+
+namespace rtlib {
+
+//Running per pixel sums for progressive rendering. Samples can be added in any
+//number of passes and the average resolved into a Canvas whenever it is wanted.
+class AccumulationBuffer {
+public:
+    typedef Canvas::PixelIndex PixelIndex;
+    
+private:
+    PixelIndex _width;
+    PixelIndex _height;
+    std::vector<float> _sums; //rgb per pixel
+    std::vector<unsigned int> _samples;
+    
+public:
+    AccumulationBuffer(PixelIndex width, PixelIndex height);
+    
+    PixelIndex width() const;
+    PixelIndex height() const;
+    
+    void addSample(PixelIndex x, PixelIndex y, const Colour& colour);
+    unsigned int sampleCount(PixelIndex x, PixelIndex y) const;
+    Colour average(PixelIndex x, PixelIndex y) const;
+    
+    void resolve(Canvas& canvas) const;
+    void clear();
+};
+
+}
+
+#endif /* accumulation_buffer_hpp */
@@ -0,0 +1,134 @@
+//
+//  antialiasing.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "antialiasing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace rtlib;
+
+AdaptiveAntialiaser::AdaptiveAntialiaser(const Camera& camera, std::shared_ptr<const Sampler> sampler) :
+    AdaptiveAntialiaser(camera, std::move(sampler), Settings())
+{
+}
+
+AdaptiveAntialiaser::AdaptiveAntialiaser(const Camera& camera, std::shared_ptr<const Sampler> sampler, Settings settings) :
+    _camera(camera),
+    _sampler(std::move(sampler)),
+    _settings(settings),
+    _base(camera.horizontalSize() * camera.verticalSize())
+{
+    if (_settings.maxSamples == 0 || _settings.batchSize == 0) {
+        throw std::invalid_argument("antialiasing needs at least one sample per batch");
+    }
+}
+
+const AdaptiveAntialiaser::Settings& AdaptiveAntialiaser::settings() const {
+    return _settings;
+}
+
+unsigned int AdaptiveAntialiaser::basePass(Canvas& canvas, const Trace& trace, unsigned int yStart, unsigned int yEnd) {
+    auto width = _camera.horizontalSize();
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            auto colour = trace(_camera.rayForPixel(x, y));
+            _base[y * width + x] = colour;
+            canvas.writePixel(x, y, colour);
+        }
+    }
+    
+    return (yEnd - yStart) * width;
+}
+
+bool AdaptiveAntialiaser::needsRefinement(unsigned int x, unsigned int y) const {
+    auto width = _camera.horizontalSize();
+    auto height = _camera.verticalSize();
+    auto centre = _base[y * width + x].luminance();
+    
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            auto nx = static_cast<int>(x) + dx;
+            auto ny = static_cast<int>(y) + dy;
+            if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= static_cast<int>(width) || ny >= static_cast<int>(height)) {
+                continue;
+            }
+            
+            if (std::abs(_base[ny * width + nx].luminance() - centre) > _settings.contrastThreshold) {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+double AdaptiveAntialiaser::filterWeight(double offsetX, double offsetY) const {
+    if (_settings.filter == Filter::Box) {
+        return 1.0;
+    }
+    
+    auto dx = offsetX - 0.5;
+    auto dy = offsetY - 0.5;
+    return std::exp(-(dx * dx + dy * dy) / (2.0 * _settings.gaussianSigma * _settings.gaussianSigma));
+}
+
+unsigned int AdaptiveAntialiaser::refinePass(Canvas& canvas, const Trace& trace, unsigned int yStart, unsigned int yEnd) const {
+    auto width = _camera.horizontalSize();
+    unsigned int traced = 0;
+    
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            if (!needsRefinement(x, y)) {
+                continue;
+            }
+            
+            //the centre sample from the base pass counts towards the pixel
+            auto base = _base[y * width + x];
+            auto weight = filterWeight(0.5, 0.5);
+            Colour weighted = base * weight;
+            auto totalWeight = weight;
+            
+            //error is judged on unweighted luminance, it only decides when to stop
+            unsigned int samples = 1;
+            double sum = base.luminance();
+            double sumSquares = sum * sum;
+            
+            while (samples < _settings.maxSamples) {
+                auto batchEnd = std::min(samples + _settings.batchSize, _settings.maxSamples);
+                for (unsigned int index = samples - 1; samples < batchEnd; index++, samples++) {
+                    auto offset = _sampler->sample2D(x, y, index, 0);
+                    auto colour = trace(_camera.rayForPixel(x, y, offset[0], offset[1]));
+                    weight = filterWeight(offset[0], offset[1]);
+                    weighted = weighted + colour * weight;
+                    totalWeight += weight;
+                    
+                    auto value = colour.luminance();
+                    sum += value;
+                    sumSquares += value * value;
+                    traced++;
+                }
+                
+                auto mean = sum / samples;
+                auto variance = std::max(0.0, sumSquares / samples - mean * mean);
+                if (std::sqrt(variance / samples) < _settings.noiseThreshold) {
+                    break;
+                }
+            }
+            
+            canvas.writePixel(x, y, weighted * (1.0 / totalWeight));
+        }
+    }
+    
+    return traced;
+}
+
+unsigned int AdaptiveAntialiaser::render(Canvas& canvas, const Trace& trace) {
+    auto traced = basePass(canvas, trace, 0, _camera.verticalSize());
+    return traced + refinePass(canvas, trace, 0, _camera.verticalSize());
+}
@@ -0,0 +1,71 @@
+//
+//  antialiasing.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef antialiasing_hpp
+#define antialiasing_hpp
+
+#include "camera.hpp"
+#include "canvas.hpp"
+#include "colour.hpp"
+#include "sampler.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace rtlib {
+
+//Adaptive supersampling. A base pass traces each pixel centre as Camera::rayForPixel
+//does, then the refine pass only revisits pixels that differ from a neighbour by more
+//than the contrast threshold, adding batches of sampler placed rays until the error of
+//the pixel's mean falls below the noise threshold or the budget runs out.
+//Both passes take row ranges so they can be split across threads, the base pass must
+//finish for every row before any refinement starts.
+class AdaptiveAntialiaser {
+public:
+    typedef std::function<Colour(const Ray&)> Trace;
+    
+    enum class Filter {
+        Box,
+        Gaussian //weights samples by their distance from the pixel centre
+    };
+    
+    struct Settings {
+        unsigned int maxSamples = 16; //including the base sample
+        unsigned int batchSize = 4;
+        double contrastThreshold = 0.05; //luminance difference to a neighbour that triggers refinement
+        double noiseThreshold = 0.01; //standard error of the mean luminance that ends refinement
+        Filter filter = Filter::Gaussian;
+        double gaussianSigma = 0.4; //in pixels
+    };
+    
+private:
+    const Camera& _camera;
+    std::shared_ptr<const Sampler> _sampler;
+    Settings _settings;
+    std::vector<Colour> _base;
+    
+public:
+    AdaptiveAntialiaser(const Camera& camera, std::shared_ptr<const Sampler> sampler);
+    AdaptiveAntialiaser(const Camera& camera, std::shared_ptr<const Sampler> sampler, Settings settings);
+    
+    const Settings& settings() const;
+    
+    //each returns the number of rays traced
+    unsigned int basePass(Canvas& canvas, const Trace& trace, unsigned int yStart, unsigned int yEnd);
+    unsigned int refinePass(Canvas& canvas, const Trace& trace, unsigned int yStart, unsigned int yEnd) const;
+    unsigned int render(Canvas& canvas, const Trace& trace);
+    
+    bool needsRefinement(unsigned int x, unsigned int y) const;
+    
+private:
+    double filterWeight(double offsetX, double offsetY) const;
+};
+
+}
+
+#endif /* antialiasing_hpp */
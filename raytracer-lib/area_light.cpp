@@ -0,0 +1,110 @@
+//
+//  area_light.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "area_light.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <stdexcept>
+
+using namespace rtlib;
+
+AreaLight::AreaLight(const Tuple& centre, const Colour& intensity, unsigned int samples, unsigned int initialSamples) :
+    Light(centre, intensity),
+    _samples(samples),
+    _initialSamples(std::min(initialSamples, samples)),
+    _initialSampler(std::max(_initialSamples, 1u)),
+    _sampler(std::max(samples - _initialSamples, 1u))
+{
+    if (_initialSamples == 0) {
+        throw std::invalid_argument("area light needs at least one shadow sample");
+    }
+}
+
+unsigned int AreaLight::sampleCount() const {
+    return _samples;
+}
+
+unsigned int AreaLight::initialSamples() const {
+    return _initialSamples;
+}
+
+Tuple AreaLight::samplePoint(unsigned int index, const Tuple& from) const {
+    //the shaded point stands in for the pixel, so neighbouring points get different jitter
+    std::hash<double> hash;
+    auto x = static_cast<unsigned int>(hash(from.x()) ^ (hash(from.z()) << 1));
+    auto y = static_cast<unsigned int>(hash(from.y()));
+    auto uv = index < _initialSamples ?
+        _initialSampler.sample2D(x, y, index, 0) :
+        _sampler.sample2D(x, y, index - _initialSamples, 0);
+    return surfacePoint(uv[0], uv[1], from);
+}
+
+RectangleLight::RectangleLight(const Tuple& corner, const Tuple& uEdge, const Tuple& vEdge, const Colour& intensity, unsigned int samples, unsigned int initialSamples) :
+    AreaLight(corner + uEdge * 0.5 + vEdge * 0.5, intensity, samples, initialSamples),
+    _corner(corner),
+    _uEdge(uEdge),
+    _vEdge(vEdge)
+{
+}
+
+Tuple RectangleLight::corner() const {
+    return _corner;
+}
+
+Tuple RectangleLight::uEdge() const {
+    return _uEdge;
+}
+
+Tuple RectangleLight::vEdge() const {
+    return _vEdge;
+}
+
+BoundingBox RectangleLight::bounds() const {
+    BoundingBox box;
+    box.addPoint(_corner);
+    box.addPoint(_corner + _uEdge);
+    box.addPoint(_corner + _vEdge);
+    box.addPoint(_corner + _uEdge + _vEdge);
+    return box;
+}
+
+Tuple RectangleLight::surfacePoint(double u, double v, const Tuple& from) const {
+    return _corner + _uEdge * u + _vEdge * v;
+}
+
+SphereLight::SphereLight(const Tuple& centre, double radius, const Colour& intensity, unsigned int samples, unsigned int initialSamples) :
+    AreaLight(centre, intensity, samples, initialSamples),
+    _radius(radius)
+{
+}
+
+double SphereLight::radius() const {
+    return _radius;
+}
+
+BoundingBox SphereLight::bounds() const {
+    auto extent = create_vector(_radius, _radius, _radius);
+    return BoundingBox(origin() - extent, origin() + extent);
+}
+
+Tuple SphereLight::surfacePoint(double u, double v, const Tuple& from) const {
+    auto centre = origin();
+    auto axis = (from - centre).normalised();
+    
+    //any two vectors perpendicular to the axis span the disk
+    auto helper = std::abs(axis.x()) > 0.9 ? create_vector(0.0, 1.0, 0.0) : create_vector(1.0, 0.0, 0.0);
+    auto tangent = Tuple::cross(helper, axis).normalised();
+    auto bitangent = Tuple::cross(axis, tangent);
+    
+    //area preserving, so strata of the unit square stay strata of the disk
+    auto r = _radius * std::sqrt(u);
+    auto phi = 2.0 * std::numbers::pi * v;
+    return centre + tangent * (r * std::cos(phi)) + bitangent * (r * std::sin(phi));
+}
@@ -0,0 +1,79 @@
+//
+//  area_light.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef area_light_hpp
+#define area_light_hpp
+
+#include "lighting.hpp"
+#include "sampler.hpp"
+
+namespace rtlib {
+
+//Lights with a surface, giving soft shadows. Shadow rays go to stratified points on
+//the surface, jittered per shaded point so penumbrae come out as noise rather than
+//banding. The initial samples are stratified on their own so even that first handful
+//spans the whole light. Shading still takes its direction from the centre, origin().
+class AreaLight : public Light {
+private:
+    unsigned int _samples;
+    unsigned int _initialSamples;
+    StratifiedSampler _initialSampler;
+    StratifiedSampler _sampler;
+    
+public:
+    AreaLight(const Tuple& centre, const Colour& intensity, unsigned int samples, unsigned int initialSamples);
+    virtual ~AreaLight() {}
+    
+    virtual unsigned int sampleCount() const;
+    virtual unsigned int initialSamples() const;
+    virtual Tuple samplePoint(unsigned int index, const Tuple& from) const;
+    
+protected:
+    //u and v in [0, 1) to a point on the light seen from from
+    virtual Tuple surfacePoint(double u, double v, const Tuple& from) const = 0;
+};
+
+//parallelogram spanned by two edges from a corner
+class RectangleLight : public AreaLight {
+private:
+    Tuple _corner;
+    Tuple _uEdge;
+    Tuple _vEdge;
+    
+public:
+    RectangleLight(const Tuple& corner, const Tuple& uEdge, const Tuple& vEdge, const Colour& intensity, unsigned int samples = 16, unsigned int initialSamples = 4);
+    
+    Tuple corner() const;
+    Tuple uEdge() const;
+    Tuple vEdge() const;
+    
+    virtual BoundingBox bounds() const;
+    
+protected:
+    virtual Tuple surfacePoint(double u, double v, const Tuple& from) const;
+};
+
+//sampled over the disk it presents to the shaded point, which is its silhouette
+//for points well outside the sphere
+class SphereLight : public AreaLight {
+private:
+    double _radius;
+    
+public:
+    SphereLight(const Tuple& centre, double radius, const Colour& intensity, unsigned int samples = 16, unsigned int initialSamples = 4);
+    
+    double radius() const;
+    
+    virtual BoundingBox bounds() const;
+    
+protected:
+    virtual Tuple surfacePoint(double u, double v, const Tuple& from) const;
+};
+
+}
+
+#endif /* area_light_hpp */
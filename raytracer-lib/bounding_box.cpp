@@ -0,0 +1,197 @@
+//
+//  bounding_box.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "bounding_box.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace rtlib;
+
+namespace {
+
+const double infinity = std::numeric_limits<double>::infinity();
+
+}
+
+BoundingBox::BoundingBox() :
+    _min(create_point(infinity, infinity, infinity)),
+    _max(create_point(-infinity, -infinity, -infinity))
+{
+}
+
+BoundingBox::BoundingBox(const Tuple& min, const Tuple& max) :
+    _min(min),
+    _max(max)
+{
+}
+
+Tuple BoundingBox::min() const {
+    return _min;
+}
+
+Tuple BoundingBox::max() const {
+    return _max;
+}
+
+bool BoundingBox::empty() const {
+    return _min.x() > _max.x() || _min.y() > _max.y() || _min.z() > _max.z();
+}
+
+bool BoundingBox::finite() const {
+    return std::isfinite(_min.x()) && std::isfinite(_min.y()) && std::isfinite(_min.z()) &&
+            std::isfinite(_max.x()) && std::isfinite(_max.y()) && std::isfinite(_max.z());
+}
+
+void BoundingBox::addPoint(const Tuple& point) {
+    _min = create_point(std::min(_min.x(), point.x()),
+                        std::min(_min.y(), point.y()),
+                        std::min(_min.z(), point.z()));
+    _max = create_point(std::max(_max.x(), point.x()),
+                        std::max(_max.y(), point.y()),
+                        std::max(_max.z(), point.z()));
+}
+
+void BoundingBox::addBox(const BoundingBox& box) {
+    if (box.empty()) {
+        return;
+    }
+
+    addPoint(box._min);
+    addPoint(box._max);
+}
+
+Tuple BoundingBox::centroid() const {
+    return create_point((_min.x() + _max.x()) * 0.5,
+                        (_min.y() + _max.y()) * 0.5,
+                        (_min.z() + _max.z()) * 0.5);
+}
+
+double BoundingBox::surfaceArea() const {
+    if (empty()) {
+        return 0.0;
+    }
+
+    auto extent = _max - _min;
+    return 2.0 * (extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x());
+}
+
+bool BoundingBox::contains(const Tuple& point) const {
+    return point.x() >= _min.x() && point.x() <= _max.x() &&
+            point.y() >= _min.y() && point.y() <= _max.y() &&
+            point.z() >= _min.z() && point.z() <= _max.z();
+}
+
+bool BoundingBox::contains(const BoundingBox& box) const {
+    return box.empty() || (contains(box._min) && contains(box._max));
+}
+
+bool BoundingBox::intersects(const Ray& ray) const {
+    return RayBoxTest(ray).intersects(*this, infinity);
+}
+
+BoundingBox BoundingBox::transform(const Matrix4x4& matrix) const {
+    if (empty()) {
+        return *this;
+    } else if (!finite()) {
+        //transforming infinite corners produces nan, so stay conservative
+        return infinite();
+    }
+
+    BoundingBox result;
+    for (unsigned int corner = 0; corner < 8; corner++) {
+        auto point = create_point(corner & 1 ? _max.x() : _min.x(),
+                                  corner & 2 ? _max.y() : _min.y(),
+                                  corner & 4 ? _max.z() : _min.z());
+        result.addPoint(matrix * point);
+    }
+
+    return result;
+}
+
+bool BoundingBox::operator==(const BoundingBox& rhs) const {
+    return _min == rhs._min && _max == rhs._max;
+}
+
+BoundingBox BoundingBox::infinite() {
+    return BoundingBox(create_point(-infinity, -infinity, -infinity),
+                       create_point(infinity, infinity, infinity));
+}
+
+RayBoxTest::RayBoxTest(const Ray& ray) {
+    auto rayOrigin = ray.origin();
+    auto rayDirection = ray.direction();
+
+    for (unsigned int axis = 0; axis < 3; axis++) {
+        origin[axis] = rayOrigin[axis];
+        inverseDirection[axis] = 1.0 / rayDirection[axis];
+    }
+}
+
+bool RayBoxTest::intersects(const BoundingBox& box, double maxDistance) const {
+    const auto min = box.min();
+    const auto max = box.max();
+    double tMin = 0.0;
+    double tMax = maxDistance;
+
+    for (unsigned int axis = 0; axis < 3; axis++) {
+        if (std::isinf(inverseDirection[axis])) {
+            //parallel to this slab, so the origin must already be between the planes
+            if (origin[axis] < min[axis] || origin[axis] > max[axis]) {
+                return false;
+            }
+            continue;
+        }
+
+        auto t1 = (min[axis] - origin[axis]) * inverseDirection[axis];
+        auto t2 = (max[axis] - origin[axis]) * inverseDirection[axis];
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+
+        tMin = std::max(tMin, t1);
+        tMax = std::min(tMax, t2);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Frustum::addPlane(const Tuple& normal, const Tuple& point) {
+    Plane plane;
+    for (unsigned int axis = 0; axis < 3; axis++) {
+        plane.normal[axis] = normal[axis];
+    }
+
+    plane.offset = -(normal.x() * point.x() + normal.y() * point.y() + normal.z() * point.z());
+    planes.push_back(plane);
+}
+
+bool Frustum::intersects(const BoundingBox& box) const {
+    if (!box.finite()) {
+        return !box.empty();
+    }
+
+    const auto min = box.min();
+    const auto max = box.max();
+    for (const auto& plane : planes) {
+        //the corner furthest along the normal, if that's outside so is the rest of the box
+        double distance = plane.offset;
+        for (unsigned int axis = 0; axis < 3; axis++) {
+            distance += plane.normal[axis] * (plane.normal[axis] >= 0.0 ? max[axis] : min[axis]);
+        }
+
+        if (distance < 0.0) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+//
+//  bounding_box.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef bounding_box_hpp
+#define bounding_box_hpp
+
+#include "matrix.hpp"
+#include "ray.hpp"
+#include "tuple.hpp"
+
+#include <vector>
+
+namespace rtlib {
+
+class BoundingBox {
+private:
+    Tuple _min;
+    Tuple _max;
+
+public:
+    BoundingBox();
+    BoundingBox(const Tuple& min, const Tuple& max);
+
+    Tuple min() const;
+    Tuple max() const;
+
+    bool empty() const;
+    bool finite() const;
+
+    void addPoint(const Tuple& point);
+    void addBox(const BoundingBox& box);
+
+    Tuple centroid() const;
+    double surfaceArea() const;
+
+    bool contains(const Tuple& point) const;
+    bool contains(const BoundingBox& box) const;
+    bool intersects(const Ray& ray) const;
+
+    BoundingBox transform(const Matrix4x4& matrix) const;
+
+    bool operator==(const BoundingBox& rhs) const;
+
+    static BoundingBox infinite();
+};
+
+//precomputed ray values used to slab test many boxes against the same ray
+struct RayBoxTest {
+    double origin[3];
+    double inverseDirection[3];
+
+    RayBoxTest(const Ray& ray);
+    bool intersects(const BoundingBox& box, double maxDistance) const;
+};
+
+//convex volume bounded by planes, a point is inside when it's on the normal's side of every one
+struct Frustum {
+    struct Plane {
+        double normal[3];
+        double offset; //-dot(normal, any point on the plane)
+    };
+
+    std::vector<Plane> planes;
+
+    void addPlane(const Tuple& normal, const Tuple& point);
+
+    //conservative, false only when the box is wholly outside one plane
+    bool intersects(const BoundingBox& box) const;
+};
+
+}
+
+#endif /* bounding_box_hpp */
@@ -0,0 +1,319 @@
+//
+//  bvh.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "bvh.hpp"
+
+#include <algorithm>
+#include <array>
+
+using namespace rtlib;
+
+namespace {
+
+const unsigned int binCount = 12;
+const unsigned int maxSahDepth = 32; //past this depth fall back to median splits to bound the traversal stack
+const double traversalCost = 1.0;
+const double intersectionCost = 1.0;
+
+struct Bin {
+    BoundingBox bounds;
+    unsigned int count = 0;
+};
+
+}
+
+BVH::BVH(std::vector<BoundingBox> primitiveBounds, unsigned int maxLeafSize) :
+    _primitiveLeaf(primitiveBounds.size(), noNode),
+    _primitiveBounds(std::move(primitiveBounds)),
+    _root(noNode),
+    _maxLeafSize(std::max(1u, maxLeafSize)),
+    _orphanedNodes(0)
+{
+    rebuild();
+}
+
+unsigned int BVH::root() const {
+    return _root;
+}
+
+const std::vector<BVH::Node>& BVH::nodes() const {
+    return _nodes;
+}
+
+const std::vector<unsigned int>& BVH::primitives() const {
+    return _primitives;
+}
+
+const BoundingBox& BVH::primitiveBounds(unsigned int primitive) const {
+    return _primitiveBounds[primitive];
+}
+
+unsigned int BVH::maxLeafSize() const {
+    return _maxLeafSize;
+}
+
+unsigned int BVH::liveNodeCount() const {
+    return static_cast<unsigned int>(_nodes.size()) - _orphanedNodes;
+}
+
+double BVH::cost() const {
+    if (_root == noNode) {
+        return 0.0;
+    }
+
+    auto area = _nodes[_root].bounds.surfaceArea();
+    return area > 0.0 ? _nodes[_root].cost / area : 0.0;
+}
+
+void BVH::setPrimitiveBounds(unsigned int primitive, const BoundingBox& bounds) {
+    _primitiveBounds[primitive] = bounds;
+}
+
+void BVH::refit(const std::vector<unsigned int>& moved) {
+    for (auto primitive : moved) {
+        //walk from the leaf to the root, stopping once a node is unaffected
+        auto node = _primitiveLeaf[primitive];
+        while (node != noNode) {
+            auto previousBounds = _nodes[node].bounds;
+            auto previousCost = _nodes[node].cost;
+            updateNode(node);
+
+            if (_nodes[node].bounds == previousBounds && _nodes[node].cost == previousCost) {
+                break;
+            }
+
+            node = _nodes[node].parent;
+        }
+    }
+}
+
+unsigned int BVH::rebuildDegraded(double threshold) {
+    if (_root == noNode) {
+        return 0;
+    }
+
+    if (_nodes[_root].cost > _nodes[_root].builtCost * threshold) {
+        rebuild();
+        return 1;
+    }
+
+    auto rebuilt = rebuildDegraded(_root, threshold);
+
+    //partial rebuilds leave the replaced nodes behind, compact once they dominate
+    if (_orphanedNodes > liveNodeCount()) {
+        rebuild();
+    }
+
+    return rebuilt;
+}
+
+void BVH::rebuild() {
+    _nodes.clear();
+    _orphanedNodes = 0;
+    _primitives.resize(_primitiveBounds.size());
+    for (unsigned int i = 0; i < _primitives.size(); i++) {
+        _primitives[i] = i;
+    }
+
+    _root = _primitives.empty() ? noNode : build(0, static_cast<unsigned int>(_primitives.size()), noNode, 0);
+}
+
+unsigned int BVH::build(unsigned int first, unsigned int count, unsigned int parent, unsigned int depth) {
+    BoundingBox bounds;
+    BoundingBox centroidBounds;
+    for (unsigned int i = first; i < first + count; i++) {
+        const auto& primitiveBounds = _primitiveBounds[_primitives[i]];
+        bounds.addBox(primitiveBounds);
+        centroidBounds.addPoint(primitiveBounds.centroid());
+    }
+
+    if (count == 1) {
+        return makeLeaf(first, count, parent, bounds);
+    }
+
+    auto extent = centroidBounds.max() - centroidBounds.min();
+    unsigned int axis = 0;
+    if (extent.y() > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z() > extent[axis]) {
+        axis = 2;
+    }
+
+    auto begin = _primitives.begin() + first;
+    auto end = begin + count;
+    unsigned int splitCount = 0;
+
+    if (extent[axis] > 0.0 && depth < maxSahDepth) {
+        std::array<Bin, binCount> bins;
+        auto axisMin = centroidBounds.min()[axis];
+        auto scale = binCount / extent[axis];
+        auto binFor = [&](unsigned int primitive) {
+            auto bin = static_cast<unsigned int>((_primitiveBounds[primitive].centroid()[axis] - axisMin) * scale);
+            return std::min(bin, binCount - 1);
+        };
+
+        for (auto it = begin; it != end; it++) {
+            auto& bin = bins[binFor(*it)];
+            bin.bounds.addBox(_primitiveBounds[*it]);
+            bin.count++;
+        }
+
+        //sweep from the right to get the cost of every candidate plane in one pass
+        std::array<double, binCount> rightCost;
+        BoundingBox rightBounds;
+        unsigned int rightCount = 0;
+        for (unsigned int i = binCount - 1; i > 0; i--) {
+            rightBounds.addBox(bins[i].bounds);
+            rightCount += bins[i].count;
+            rightCost[i] = rightBounds.surfaceArea() * rightCount;
+        }
+
+        BoundingBox leftBounds;
+        unsigned int leftCount = 0;
+        double bestCost = std::numeric_limits<double>::infinity();
+        unsigned int bestSplit = 0;
+        for (unsigned int i = 0; i < binCount - 1; i++) {
+            leftBounds.addBox(bins[i].bounds);
+            leftCount += bins[i].count;
+            auto splitCost = leftBounds.surfaceArea() * leftCount + rightCost[i + 1];
+            if (splitCost < bestCost) {
+                bestCost = splitCost;
+                bestSplit = i;
+            }
+        }
+
+        auto leafCost = intersectionCost * count;
+        auto sahCost = traversalCost + intersectionCost * bestCost / bounds.surfaceArea();
+        if (count <= _maxLeafSize && leafCost <= sahCost) {
+            return makeLeaf(first, count, parent, bounds);
+        }
+
+        auto middle = std::partition(begin, end, [&](unsigned int primitive) {
+            return binFor(primitive) <= bestSplit;
+        });
+        splitCount = static_cast<unsigned int>(middle - begin);
+    } else if (count <= _maxLeafSize) {
+        return makeLeaf(first, count, parent, bounds);
+    }
+
+    if (splitCount == 0 || splitCount == count) {
+        //all centroids coincide or sah could not separate them, so split on the median
+        splitCount = count / 2;
+        std::nth_element(begin, begin + splitCount, end, [&](unsigned int a, unsigned int b) {
+            return _primitiveBounds[a].centroid()[axis] < _primitiveBounds[b].centroid()[axis];
+        });
+    }
+
+    auto index = static_cast<unsigned int>(_nodes.size());
+    _nodes.emplace_back();
+    _nodes[index].parent = parent;
+    _nodes[index].first = first;
+    _nodes[index].count = count;
+
+    auto left = build(first, splitCount, index, depth + 1);
+    auto right = build(first + splitCount, count - splitCount, index, depth + 1);
+    _nodes[index].left = left;
+    _nodes[index].right = right;
+    updateNode(index);
+    _nodes[index].builtCost = _nodes[index].cost;
+
+    return index;
+}
+
+unsigned int BVH::makeLeaf(unsigned int first, unsigned int count, unsigned int parent, const BoundingBox& bounds) {
+    auto index = static_cast<unsigned int>(_nodes.size());
+    _nodes.emplace_back();
+
+    auto& node = _nodes.back();
+    node.bounds = bounds;
+    node.parent = parent;
+    node.first = first;
+    node.count = count;
+    node.leaf = true;
+    node.cost = intersectionCost * bounds.surfaceArea() * count;
+    node.builtCost = node.cost;
+
+    for (unsigned int i = first; i < first + count; i++) {
+        _primitiveLeaf[_primitives[i]] = index;
+    }
+
+    return index;
+}
+
+void BVH::updateNode(unsigned int index) {
+    auto& node = _nodes[index];
+    node.bounds = BoundingBox();
+
+    if (node.leaf) {
+        for (unsigned int i = node.first; i < node.first + node.count; i++) {
+            node.bounds.addBox(_primitiveBounds[_primitives[i]]);
+        }
+        node.cost = intersectionCost * node.bounds.surfaceArea() * node.count;
+    } else {
+        const auto& left = _nodes[node.left];
+        const auto& right = _nodes[node.right];
+        node.bounds.addBox(left.bounds);
+        node.bounds.addBox(right.bounds);
+        node.cost = traversalCost * node.bounds.surfaceArea() + left.cost + right.cost;
+    }
+}
+
+void BVH::rebuildSubtree(unsigned int index) {
+    unsigned int depth = 0;
+    for (auto node = _nodes[index].parent; node != noNode; node = _nodes[node].parent) {
+        depth++;
+    }
+
+    //every old node is discarded bar the slot at index, which is reused, while the
+    //replacement root's own slot is left empty, so the orphan count grows by the full size
+    _orphanedNodes += subtreeSize(index);
+
+    auto parent = _nodes[index].parent;
+    auto replacement = build(_nodes[index].first, _nodes[index].count, parent, depth);
+
+    //the new subtree root takes over the old slot so the parent link stays valid
+    _nodes[index] = _nodes[replacement];
+    if (_nodes[index].leaf) {
+        for (unsigned int i = _nodes[index].first; i < _nodes[index].first + _nodes[index].count; i++) {
+            _primitiveLeaf[_primitives[i]] = index;
+        }
+    } else {
+        _nodes[_nodes[index].left].parent = index;
+        _nodes[_nodes[index].right].parent = index;
+    }
+    _nodes[replacement] = Node();
+
+    for (auto node = parent; node != noNode; node = _nodes[node].parent) {
+        updateNode(node);
+    }
+}
+
+unsigned int BVH::rebuildDegraded(unsigned int index, double threshold) {
+    const auto& node = _nodes[index];
+    if (node.leaf) {
+        return 0;
+    }
+
+    if (node.cost > node.builtCost * threshold) {
+        rebuildSubtree(index);
+        return 1;
+    }
+
+    auto left = node.left;
+    auto right = node.right;
+    return rebuildDegraded(left, threshold) + rebuildDegraded(right, threshold);
+}
+
+unsigned int BVH::subtreeSize(unsigned int index) const {
+    const auto& node = _nodes[index];
+    if (node.leaf) {
+        return 1;
+    }
+
+    return 1 + subtreeSize(node.left) + subtreeSize(node.right);
+}
@@ -0,0 +1,141 @@
+//
+//  bvh.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef bvh_hpp
+#define bvh_hpp
+
+#include "bounding_box.hpp"
+#include "ray.hpp"
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace rtlib {
+
+//traversal visitors may return true to end the walk early, such as once any-hit
+//queries have their answer, visitors returning nothing always carry on
+template<typename Function, typename... Args>
+bool visitEndsTraversal(Function& visit, Args... args) {
+    if constexpr (std::is_same_v<std::invoke_result_t<Function&, Args...>, bool>) {
+        return visit(args...);
+    } else {
+        visit(args...);
+        return false;
+    }
+}
+
+//Binary bounding volume hierarchy built with the surface area heuristic (SAH).
+//Primitives are referenced by index so the same tree can sit over world objects
+//or any other list of bounded things.
+class BVH {
+public:
+    static constexpr unsigned int noNode = std::numeric_limits<unsigned int>::max();
+
+    struct Node {
+        BoundingBox bounds;
+        unsigned int left = noNode;
+        unsigned int right = noNode;
+        unsigned int parent = noNode;
+        unsigned int first = 0; //range into primitives() covered by this subtree
+        unsigned int count = 0;
+        bool leaf = false;
+        double cost = 0.0; //unnormalised SAH cost of the subtree
+        double builtCost = 0.0; //cost when the subtree was last built, used to judge refit quality
+    };
+
+private:
+    std::vector<Node> _nodes;
+    std::vector<unsigned int> _primitives;
+    std::vector<unsigned int> _primitiveLeaf;
+    std::vector<BoundingBox> _primitiveBounds;
+    unsigned int _root;
+    unsigned int _maxLeafSize;
+    unsigned int _orphanedNodes;
+
+public:
+    BVH(std::vector<BoundingBox> primitiveBounds, unsigned int maxLeafSize = 4);
+
+    unsigned int root() const;
+    const std::vector<Node>& nodes() const;
+    const std::vector<unsigned int>& primitives() const;
+    const BoundingBox& primitiveBounds(unsigned int primitive) const;
+    unsigned int maxLeafSize() const;
+    unsigned int liveNodeCount() const;
+    double cost() const;
+
+    void setPrimitiveBounds(unsigned int primitive, const BoundingBox& bounds);
+    void refit(const std::vector<unsigned int>& moved);
+    unsigned int rebuildDegraded(double threshold);
+    void rebuild();
+
+    //both return the number of nodes visited
+    template<typename Function>
+    unsigned int traverse(const Ray& ray, double maxDistance, Function visitPrimitive) const;
+    
+    //visits each hit leaf as a (first, count) range into primitives(), for callers
+    //that store their primitive data in leaf order and test whole leaves at once
+    template<typename Function>
+    unsigned int traverseLeaves(const Ray& ray, double maxDistance, Function visitLeaf) const;
+
+private:
+    unsigned int build(unsigned int first, unsigned int count, unsigned int parent, unsigned int depth);
+    unsigned int makeLeaf(unsigned int first, unsigned int count, unsigned int parent, const BoundingBox& bounds);
+    void updateNode(unsigned int node);
+    void rebuildSubtree(unsigned int node);
+    unsigned int rebuildDegraded(unsigned int node, double threshold);
+    unsigned int subtreeSize(unsigned int node) const;
+};
+
+template<typename Function>
+unsigned int BVH::traverse(const Ray& ray, double maxDistance, Function visitPrimitive) const {
+    return traverseLeaves(ray, maxDistance, [&](unsigned int first, unsigned int count) {
+        for (unsigned int i = first; i < first + count; i++) {
+            if (visitEndsTraversal(visitPrimitive, _primitives[i])) {
+                return true;
+            }
+        }
+        
+        return false;
+    });
+}
+
+template<typename Function>
+unsigned int BVH::traverseLeaves(const Ray& ray, double maxDistance, Function visitLeaf) const {
+    if (_root == noNode) {
+        return 0;
+    }
+
+    RayBoxTest test(ray);
+    unsigned int stack[64];
+    unsigned int stackSize = 0;
+    unsigned int visited = 0;
+    stack[stackSize++] = _root;
+
+    while (stackSize > 0) {
+        const auto& node = _nodes[stack[--stackSize]];
+        visited++;
+        if (!test.intersects(node.bounds, maxDistance)) {
+            continue;
+        }
+
+        if (node.leaf) {
+            if (visitEndsTraversal(visitLeaf, node.first, node.count)) {
+                break;
+            }
+        } else {
+            stack[stackSize++] = node.right;
+            stack[stackSize++] = node.left;
+        }
+    }
+
+    return visited;
+}
+
+}
+
+#endif /* bvh_hpp */
@@ -7,13 +7,55 @@
 
 #include "camera.hpp"
 
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
 using namespace rtlib;
 
+namespace {
+
+//Shirley and Chiu's concentric mapping from the unit square to the unit disk, which
+//keeps strata compact and equal in area
+std::array<double, 2> concentricDisk(double u, double v) {
+    auto a = 2.0 * u - 1.0;
+    auto b = 2.0 * v - 1.0;
+    if (a == 0.0 && b == 0.0) {
+        return {0.0, 0.0};
+    }
+    
+    double radius, angle;
+    if (std::abs(a) > std::abs(b)) {
+        radius = a;
+        angle = (std::numbers::pi / 4.0) * (b / a);
+    } else {
+        radius = b;
+        angle = std::numbers::pi / 2.0 - (std::numbers::pi / 4.0) * (a / b);
+    }
+    
+    return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+
+}
+
+unsigned int Camera::TileRays::size() const {
+    return static_cast<unsigned int>(directionX.size());
+}
+
+Ray Camera::TileRays::ray(unsigned int index) const {
+    return Ray(origin, create_vector(directionX[index], directionY[index], directionZ[index]), time);
+}
+
 Camera::Camera(unsigned int horizontalSize, unsigned int verticalSize, double fieldOfView) :
     _horizontalSize(horizontalSize),
     _verticalSize(verticalSize),
     _fieldOfView(fieldOfView),
-    _transform(Matrix4x4::identityMatrix())
+    _transform(Matrix4x4::identityMatrix()),
+    _apertureRadius(0.0),
+    _focalDistance(1.0),
+    _shutterOpen(0.0),
+    _shutterClose(0.0)
 {
     auto halfView = std::tan(_fieldOfView / 2.0);
     auto aspectRatio = static_cast<double>(_horizontalSize) / static_cast<double>(_verticalSize);
@@ -22,6 +64,7 @@ Camera::Camera(unsigned int horizontalSize, unsigned int verticalSize, double fi
     _halfHeight = aspectRatio >= 1 ? halfView / aspectRatio : halfView;
     
     _pixelSize = (_halfWidth * 2) / _horizontalSize;
+    updateRayBasis();
 }
 
 unsigned int Camera::horizontalSize() const {
@@ -38,27 +81,183 @@ double Camera::fieldOfView() const {
 
 void Camera::setTransform(Matrix4x4 transform) {
     _transform = transform;
+    updateRayBasis();
+}
+
+void Camera::updateRayBasis() {
+    _inverseTransform = _transform.inverse();
+    _origin = _inverseTransform * create_point(0.0, 0.0, 0.0);
+    _corner = _inverseTransform * create_point(_halfWidth, _halfHeight, -1.0) - _origin;
+    _stepX = _inverseTransform * create_vector(-_pixelSize, 0.0, 0.0);
+    _stepY = _inverseTransform * create_vector(0.0, -_pixelSize, 0.0);
 }
 
 Matrix4x4 Camera::transform() const {
     return _transform;
 }
 
+void Camera::setLens(double apertureRadius, double focalDistance) {
+    if (apertureRadius < 0.0 || focalDistance <= 0.0) {
+        throw std::invalid_argument("lens needs a non-negative aperture and a positive focal distance");
+    }
+    
+    _apertureRadius = apertureRadius;
+    _focalDistance = focalDistance;
+}
+
+double Camera::apertureRadius() const {
+    return _apertureRadius;
+}
+
+double Camera::focalDistance() const {
+    return _focalDistance;
+}
+
+bool Camera::isPinhole() const {
+    return _apertureRadius == 0.0;
+}
+
+void Camera::setShutter(double open, double close) {
+    if (close < open) {
+        throw std::invalid_argument("shutter closes before it opens");
+    }
+    
+    _shutterOpen = open;
+    _shutterClose = close;
+}
+
+double Camera::shutterOpen() const {
+    return _shutterOpen;
+}
+
+double Camera::shutterClose() const {
+    return _shutterClose;
+}
+
+bool Camera::hasMotionBlur() const {
+    return _shutterClose > _shutterOpen;
+}
+
+double Camera::shutterTime(double sample) const {
+    return _shutterOpen + (_shutterClose - _shutterOpen) * sample;
+}
+
 double Camera::pixelSize() const {
     return _pixelSize;
 }
 
 Ray Camera::rayForPixel(unsigned int x, unsigned int y) const {
-    auto xOffset = (static_cast<double >(x) + 0.5) * _pixelSize;
-    auto yOffset = (static_cast<double >(y) + 0.5) * _pixelSize;
+    return rayForPixel(x, y, 0.5, 0.5);
+}
+
+Ray Camera::rayForPixel(unsigned int x, unsigned int y, double offsetX, double offsetY) const {
+    auto xOffset = (static_cast<double >(x) + offsetX) * _pixelSize;
+    auto yOffset = (static_cast<double >(y) + offsetY) * _pixelSize;
     
     auto worldX = _halfWidth - xOffset;
     auto worldY = _halfHeight - yOffset;
     
-    auto pixel = _transform.inverse() * create_point(worldX, worldY, -1.0);
-    auto origin = _transform.inverse() * create_point(0.0, 0.0, 0.0);
-    auto direction = (pixel - origin).normalised();
+    auto pixel = _inverseTransform * create_point(worldX, worldY, -1.0);
+    auto direction = (pixel - _origin).normalised();
+    
+    return Ray(_origin, direction, _shutterOpen);
+}
+
+Ray Camera::rayForPixel(unsigned int x, unsigned int y, double offsetX, double offsetY, double lensU, double lensV) const {
+    if (isPinhole()) {
+        return rayForPixel(x, y, offsetX, offsetY);
+    }
+    
+    //the pinhole ray's point at the focal distance stays put, the origin moves across the lens
+    auto worldX = _halfWidth - (static_cast<double>(x) + offsetX) * _pixelSize;
+    auto worldY = _halfHeight - (static_cast<double>(y) + offsetY) * _pixelSize;
+    auto focus = _inverseTransform * create_point(worldX * _focalDistance, worldY * _focalDistance, -_focalDistance);
+    
+    auto lens = concentricDisk(lensU, lensV);
+    auto origin = _inverseTransform * create_point(lens[0] * _apertureRadius, lens[1] * _apertureRadius, 0.0);
+    
+    return Ray(origin, (focus - origin).normalised(), _shutterOpen);
+}
+
+double Camera::circleOfConfusion(const Tuple& point) const {
+    auto depth = -(_transform * point).z();
+    if (depth <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
     
-    return Ray(origin, direction);
+    //the lens's rays spread by its diameter scaled by how far the depth is from the focal plane,
+    //projected back onto the canvas at z = -1
+    return 2.0 * _apertureRadius * std::abs(1.0 / depth - 1.0 / _focalDistance) / _pixelSize;
 }
 
+
+std::optional<std::array<unsigned int, 2>> Camera::pixelForPoint(const Tuple& point) const {
+    //rayForPixel in reverse, onto the canvas plane at z = -1
+    auto local = _transform * point;
+    if (local.z() >= 0.0) {
+        return std::nullopt;
+    }
+    
+    auto x = (_halfWidth - local.x() / -local.z()) / _pixelSize;
+    auto y = (_halfHeight - local.y() / -local.z()) / _pixelSize;
+    if (x < 0.0 || y < 0.0 || x >= _horizontalSize || y >= _verticalSize) {
+        return std::nullopt;
+    }
+    
+    return std::array<unsigned int, 2>{static_cast<unsigned int>(x), static_cast<unsigned int>(y)};
+}
+
+void Camera::raysForTile(unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd, TileRays& rays) const {
+    raysForTile(xStart, yStart, xEnd, yEnd, 0.5, 0.5, rays);
+}
+
+void Camera::raysForTile(unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd, double offsetX, double offsetY, TileRays& rays) const {
+    auto width = xEnd - xStart;
+    auto count = width * (yEnd - yStart);
+    rays.origin = _origin;
+    rays.time = _shutterOpen;
+    rays.directionX.resize(count);
+    rays.directionY.resize(count);
+    rays.directionZ.resize(count);
+    
+    //the unnormalised direction moves by a fixed step per pixel, so each row only adds
+    const double stepX[3] = {_stepX.x(), _stepX.y(), _stepX.z()};
+    unsigned int index = 0;
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        auto rowStart = _corner + _stepX * (xStart + offsetX) + _stepY * (y + offsetY);
+        double direction[3] = {rowStart.x(), rowStart.y(), rowStart.z()};
+        
+        for (unsigned int x = 0; x < width; x++, index++) {
+            auto length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+            rays.directionX[index] = direction[0] / length;
+            rays.directionY[index] = direction[1] / length;
+            rays.directionZ[index] = direction[2] / length;
+            
+            direction[0] += stepX[0];
+            direction[1] += stepX[1];
+            direction[2] += stepX[2];
+        }
+    }
+}
+
+Frustum Camera::tileFrustum(unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd) const {
+    auto edge = [this](unsigned int x, unsigned int y) {
+        return _corner + _stepX * static_cast<double>(x) + _stepY * static_cast<double>(y);
+    };
+    
+    //corners in order round the tile, each side's plane holds the origin and two of them
+    const std::array<Tuple, 4> corners = {edge(xStart, yStart), edge(xEnd, yStart), edge(xEnd, yEnd), edge(xStart, yEnd)};
+    auto centre = (corners[0] + corners[2]) * 0.5;
+    
+    Frustum frustum;
+    for (unsigned int i = 0; i < corners.size(); i++) {
+        auto normal = Tuple::cross(corners[i], corners[(i + 1) % corners.size()]);
+        if (Tuple::dot(normal, centre) < 0.0) {
+            normal = -normal;
+        }
+        
+        frustum.addPlane(normal, _origin);
+    }
+    
+    return frustum;
+}
@@ -8,11 +8,29 @@
 #ifndef camera_hpp
 #define camera_hpp
 
+#include "bounding_box.hpp"
 #include "matrix.hpp"
 #include "ray.hpp"
 
+#include <array>
+#include <optional>
+#include <vector>
+
 namespace rtlib {
     class Camera {
+    public:
+        //primary rays for a tile, row by row, all sharing the camera's origin
+        struct TileRays {
+            Tuple origin;
+            double time;
+            std::vector<double> directionX;
+            std::vector<double> directionY;
+            std::vector<double> directionZ;
+            
+            unsigned int size() const;
+            Ray ray(unsigned int index) const;
+        };
+        
     private:
         unsigned int _horizontalSize;
         unsigned int _verticalSize;
@@ -22,6 +40,21 @@ namespace rtlib {
         double _halfHeight;
         double _pixelSize;
         
+        //derived from the transform when it's set, so rays need no inverse
+        Matrix4x4 _inverseTransform;
+        Tuple _origin;
+        Tuple _corner; //origin to the top left of the canvas
+        Tuple _stepX; //one pixel right on the canvas
+        Tuple _stepY; //one pixel down
+        
+        //thin lens, a radius of zero is a pinhole
+        double _apertureRadius;
+        double _focalDistance;
+        
+        //ray times are spread over [_shutterOpen, _shutterClose], objects move over [0, 1]
+        double _shutterOpen;
+        double _shutterClose;
+        
     public:
         Camera(unsigned int horizontalSize, unsigned int verticalSize, double fieldOfView);
                 
@@ -33,7 +66,35 @@ namespace rtlib {
         void setTransform(Matrix4x4 transform);
         Matrix4x4 transform() const;
         
+        //focalDistance is along the view direction, where rays from every lens point meet
+        void setLens(double apertureRadius, double focalDistance);
+        double apertureRadius() const;
+        double focalDistance() const;
+        bool isPinhole() const;
+        
+        void setShutter(double open, double close);
+        double shutterOpen() const;
+        double shutterClose() const;
+        bool hasMotionBlur() const; //the shutter stays open for a while
+        double shutterTime(double sample) const; //maps a sample in [0, 1) to a time the shutter is open
+        
         Ray rayForPixel(unsigned int x, unsigned y) const;
+        Ray rayForPixel(unsigned int x, unsigned y, double offsetX, double offsetY) const; //offsets within the pixel, 0.5 is the centre
+        Ray rayForPixel(unsigned int x, unsigned y, double offsetX, double offsetY, double lensU, double lensV) const; //lens sample in [0, 1)², strata map to even areas of the aperture
+        
+        //diameter in pixels of the blur a point gets from the lens, zero at the focal distance
+        double circleOfConfusion(const Tuple& point) const;
+        std::optional<std::array<unsigned int, 2>> pixelForPoint(const Tuple& point) const; //empty behind the camera or off the canvas
+        
+        //pinhole rays through [xStart, xEnd) x [yStart, yEnd), stepping the direction from pixel to pixel
+        void raysForTile(unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd, TileRays& rays) const;
+        void raysForTile(unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd, double offsetX, double offsetY, TileRays& rays) const;
+        
+        //the pyramid from the origin through the tile's outer pixel edges, holding every pinhole ray of the tile
+        Frustum tileFrustum(unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd) const;
+        
+    private:
+        void updateRayBasis();
     };
 }
 
@@ -36,6 +36,10 @@ double Colour::blue() const {
     return z();
 }
 
+double Colour::luminance() const {
+    return 0.2126 * red() + 0.7152 * green() + 0.0722 * blue();
+}
+
 Colour& Colour::operator*=(const Colour& rhs) {
     this->_vector.x *= rhs.x();
     this->_vector.y *= rhs.y();
@@ -22,6 +22,7 @@ public:
     double red() const;
     double green() const;
     double blue() const;
+    double luminance() const; //Rec. 709 weights
     
     Colour& operator*=(const Colour& rhs);
 };
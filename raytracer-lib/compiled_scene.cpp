@@ -0,0 +1,292 @@
+//
+//  compiled_scene.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "compiled_scene.hpp"
+
+#include "object.hpp"
+#include "pattern.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+
+#include <typeinfo>
+
+using namespace rtlib;
+
+namespace {
+
+Intersect compiledHit(const Object* object, double t, unsigned int entry) {
+    Intersect hit(object, t);
+    hit.entry = entry;
+    return hit;
+}
+
+}
+
+CompiledScene::CompiledScene(const std::vector<std::unique_ptr<Object>>& objects) {
+    _objects.reserve(objects.size());
+    for (const auto& object : objects) {
+        _objects.push_back(object.get());
+    }
+
+    _entries.resize(_objects.size());
+    for (unsigned int i = 0; i < _objects.size(); i++) {
+        //exact type matches only, a subclass may override the maths
+        const auto& type = typeid(*_objects[i]);
+        auto kind = ShapeKind::Other;
+        if (type == typeid(Sphere)) {
+            kind = ShapeKind::Sphere;
+        } else if (type == typeid(Plane)) {
+            kind = ShapeKind::Plane;
+        }
+
+        auto& shapes = group(kind);
+        _entries[i].shape = kind;
+        _entries[i].index = static_cast<unsigned int>(shapes.objects.size());
+        shapes.objects.push_back(_objects[i]);
+        shapes.entries.push_back(i);
+        shapes.inverses.emplace_back();
+        shapes.normalTransforms.emplace_back();
+        shapes.moving.push_back(0);
+
+        compileEntry(i);
+    }
+}
+
+std::size_t CompiledScene::size() const {
+    return _objects.size();
+}
+
+CompiledScene::ShapeKind CompiledScene::shapeKind(unsigned int object) const {
+    return _entries[object].shape;
+}
+
+void CompiledScene::update() {
+    for (unsigned int i = 0; i < _objects.size(); i++) {
+        if (_objects[i]->transformVersion() != _entries[i].transformVersion || materialStale(_entries[i], _objects[i])) {
+            compileEntry(i);
+        }
+    }
+}
+
+bool CompiledScene::holds(const std::vector<std::unique_ptr<Object>>& objects) const {
+    if (objects.size() != _objects.size()) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < _objects.size(); i++) {
+        if (objects[i].get() != _objects[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CompiledScene::moved() const {
+    for (unsigned int i = 0; i < _objects.size(); i++) {
+        if (_objects[i]->transformVersion() != _entries[i].transformVersion) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Intersections CompiledScene::intersects(const Ray& ray) const {
+    Intersections hits;
+
+    for (unsigned int i = 0; i < _spheres.objects.size(); i++) {
+        if (_spheres.moving[i]) {
+            auto objectHits = _spheres.objects[i]->intersects(ray);
+            hits.insert(hits.end(), objectHits.begin(), objectHits.end());
+            continue;
+        }
+
+        auto localRay = ray.transform(_spheres.inverses[i]);
+        double t1, t2;
+        if (Sphere::localIntersects(localRay, t1, t2)) {
+            hits.push_back(compiledHit(_spheres.objects[i], t1, _spheres.entries[i]));
+            hits.push_back(compiledHit(_spheres.objects[i], t2, _spheres.entries[i]));
+        }
+    }
+
+    for (unsigned int i = 0; i < _planes.objects.size(); i++) {
+        if (_planes.moving[i]) {
+            auto objectHits = _planes.objects[i]->intersects(ray);
+            hits.insert(hits.end(), objectHits.begin(), objectHits.end());
+            continue;
+        }
+
+        auto localRay = ray.transform(_planes.inverses[i]);
+        double t;
+        if (Plane::localIntersects(localRay, t)) {
+            hits.push_back(compiledHit(_planes.objects[i], t, _planes.entries[i]));
+        }
+    }
+
+    for (auto object : _others.objects) {
+        auto objectHits = object->intersectsToFirstHit(ray);
+        hits.insert(hits.end(), objectHits.begin(), objectHits.end());
+    }
+
+    return hits;
+}
+
+void CompiledScene::intersects(unsigned int object, const Ray& ray, Intersections& hits) const {
+    const auto& entry = _entries[object];
+
+    switch (entry.moving ? ShapeKind::Other : entry.shape) {
+        case ShapeKind::Sphere: {
+            auto localRay = ray.transform(_spheres.inverses[entry.index]);
+            double t1, t2;
+            if (Sphere::localIntersects(localRay, t1, t2)) {
+                hits.push_back(compiledHit(_objects[object], t1, object));
+                hits.push_back(compiledHit(_objects[object], t2, object));
+            }
+            return;
+        }
+
+        case ShapeKind::Plane: {
+            auto localRay = ray.transform(_planes.inverses[entry.index]);
+            double t;
+            if (Plane::localIntersects(localRay, t)) {
+                hits.push_back(compiledHit(_objects[object], t, object));
+            }
+            return;
+        }
+
+        case ShapeKind::Other: {
+            auto objectHits = _objects[object]->intersectsToFirstHit(ray);
+            hits.insert(hits.end(), objectHits.begin(), objectHits.end());
+            return;
+        }
+    }
+}
+
+Tuple CompiledScene::normalAt(const Intersect& hit, const Tuple& point) const {
+    const auto* found = entryFor(hit);
+    if (!found) {
+        return hit.object->normalAt(point, hit);
+    }
+
+    const auto& entry = *found;
+
+    const auto& shapes = group(entry.shape);
+    auto localPoint = shapes.inverses[entry.index] * point;
+    auto localNormal = entry.shape == ShapeKind::Sphere ? Sphere::localNormal(localPoint) : Plane::localNormal(localPoint);
+
+    auto worldNormal = shapes.normalTransforms[entry.index] * localNormal;
+    worldNormal.setW(0.0);
+    return worldNormal.normalised();
+}
+
+Colour CompiledScene::colourAt(const Intersect& hit, const Tuple& point) const {
+    const auto* object = hit.object;
+    const auto* found = entryFor(hit);
+    if (!found || materialStale(*found, object)) {
+        //other shapes may vary their material per primitive, moving ones need the hit's time
+        return object->materialAt(hit).colourAt(object, point, hit.time);
+    }
+
+    const auto& entry = *found;
+    if (entry.pattern == PatternKind::None) {
+        return entry.colour;
+    } else if (entry.pattern == PatternKind::Other) {
+        return entry.patternPtr->colourAt(object, point);
+    }
+
+    const auto& shapes = group(entry.shape);
+    auto patternPoint = entry.patternInverse * (shapes.inverses[entry.index] * point);
+
+    //the built in patterns are final, so these calls bind statically
+    switch (entry.pattern) {
+        case PatternKind::Stripe:
+            return static_cast<const StripePattern*>(entry.patternPtr)->colourAtLocalPoint(patternPoint);
+
+        case PatternKind::Gradient:
+            return static_cast<const GradientPattern*>(entry.patternPtr)->colourAtLocalPoint(patternPoint);
+
+        case PatternKind::Ring:
+            return static_cast<const RingPattern*>(entry.patternPtr)->colourAtLocalPoint(patternPoint);
+
+        case PatternKind::Checkers:
+            return static_cast<const CheckersPattern*>(entry.patternPtr)->colourAtLocalPoint(patternPoint);
+
+        default:
+            return entry.patternPtr->colourAt(object, point);
+    }
+}
+
+void CompiledScene::compileEntry(unsigned int object) {
+    auto& entry = _entries[object];
+    auto& shapes = group(entry.shape);
+    const auto* obj = _objects[object];
+
+    auto inverse = obj->transform().inverse();
+    shapes.inverses[entry.index] = inverse;
+    shapes.normalTransforms[entry.index] = inverse.transpose();
+    shapes.moving[entry.index] = obj->isMoving();
+    entry.moving = obj->isMoving();
+    entry.transformVersion = obj->transformVersion();
+    entry.materialVersion = obj->materialVersion();
+
+    const auto material = obj->material();
+    entry.colour = material._colour;
+    entry.patternPtr = material._pattern.get();
+    entry.pattern = PatternKind::None;
+
+    if (entry.patternPtr) {
+        entry.patternVersion = entry.patternPtr->transformVersion();
+        entry.patternInverse = entry.patternPtr->transform().inverse();
+
+        const auto& type = typeid(*entry.patternPtr);
+        if (type == typeid(StripePattern)) {
+            entry.pattern = PatternKind::Stripe;
+        } else if (type == typeid(GradientPattern)) {
+            entry.pattern = PatternKind::Gradient;
+        } else if (type == typeid(RingPattern)) {
+            entry.pattern = PatternKind::Ring;
+        } else if (type == typeid(CheckersPattern)) {
+            entry.pattern = PatternKind::Checkers;
+        } else {
+            entry.pattern = PatternKind::Other;
+        }
+    }
+}
+
+const CompiledScene::Entry* CompiledScene::entryFor(const Intersect& hit) const {
+    //only hits this scene found on its own specialised shapes skip the virtual calls
+    if (hit.entry >= _entries.size() || _objects[hit.entry] != hit.object) {
+        return nullptr;
+    }
+
+    const auto& entry = _entries[hit.entry];
+    return entry.shape == ShapeKind::Other || entry.moving ? nullptr : &entry;
+}
+
+bool CompiledScene::materialStale(const Entry& entry, const Object* object) const {
+    //the pattern is only looked at when the material still holds it
+    return entry.materialVersion != object->materialVersion() ||
+        (entry.patternPtr && entry.patternPtr->transformVersion() != entry.patternVersion);
+}
+
+CompiledScene::ShapeGroup& CompiledScene::group(ShapeKind kind) {
+    switch (kind) {
+        case ShapeKind::Sphere:
+            return _spheres;
+
+        case ShapeKind::Plane:
+            return _planes;
+
+        default:
+            return _others;
+    }
+}
+
+const CompiledScene::ShapeGroup& CompiledScene::group(ShapeKind kind) const {
+    return const_cast<CompiledScene*>(this)->group(kind);
+}
@@ -0,0 +1,105 @@
+//
+//  compiled_scene.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef compiled_scene_hpp
+#define compiled_scene_hpp
+
+#include "colour.hpp"
+#include "intersection.hpp"
+#include "matrix.hpp"
+#include "ray.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rtlib {
+
+class Object;
+class Pattern;
+
+//Render time snapshot of the world's objects grouped by concrete type. Each group
+//keeps its inverse transforms in a contiguous array and is intersected with a
+//plain loop over the shape's inline object space maths instead of virtual calls.
+//Types without a specialised group fall back to the virtual Object interface, as do
+//moving objects, whose transform depends on the ray's time. Like World::intersects,
+//that fallback only asks for hits up to each object's first one.
+//
+//Hits found here carry their entry index so shading doesn't have to look the object
+//up. Material edits are picked up by update(), until then hits on an edited object
+//are shaded through its material as they would be without a compiled scene.
+class CompiledScene {
+public:
+    enum class ShapeKind : uint8_t {
+        Sphere,
+        Plane,
+        Other
+    };
+
+    enum class PatternKind : uint8_t {
+        None,
+        Stripe,
+        Gradient,
+        Ring,
+        Checkers,
+        Other
+    };
+
+private:
+    struct ShapeGroup {
+        std::vector<const Object*> objects;
+        std::vector<unsigned int> entries;
+        std::vector<Matrix4x4> inverses;
+        std::vector<Matrix4x4> normalTransforms;
+        std::vector<unsigned char> moving;
+    };
+
+    struct Entry {
+        ShapeKind shape;
+        unsigned int index; //position within the shape's group
+        unsigned int transformVersion;
+        unsigned int materialVersion;
+        unsigned int patternVersion;
+        bool moving;
+        PatternKind pattern;
+        const Pattern* patternPtr;
+        Matrix4x4 patternInverse;
+        Colour colour;
+    };
+
+    ShapeGroup _spheres;
+    ShapeGroup _planes;
+    ShapeGroup _others;
+    std::vector<Entry> _entries;
+    std::vector<const Object*> _objects;
+
+public:
+    CompiledScene(const std::vector<std::unique_ptr<Object>>& objects);
+
+    std::size_t size() const;
+    ShapeKind shapeKind(unsigned int object) const;
+    void update(); //recompiles objects whose transform or material changed
+    bool holds(const std::vector<std::unique_ptr<Object>>& objects) const; //the same objects in the same order
+    bool moved() const; //any object's transform changed since it was compiled
+
+    Intersections intersects(const Ray& ray) const;
+    void intersects(unsigned int object, const Ray& ray, Intersections& hits) const;
+
+    Tuple normalAt(const Intersect& hit, const Tuple& point) const;
+    Colour colourAt(const Intersect& hit, const Tuple& point) const;
+
+private:
+    void compileEntry(unsigned int object);
+    const Entry* entryFor(const Intersect& hit) const;
+    bool materialStale(const Entry& entry, const Object* object) const;
+    ShapeGroup& group(ShapeKind kind);
+    const ShapeGroup& group(ShapeKind kind) const;
+};
+
+}
+
+#endif /* compiled_scene_hpp */
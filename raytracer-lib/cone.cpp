@@ -0,0 +1,100 @@
+//
+//  cone.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "cone.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double epsilon = 0.00001;
+
+}
+
+rtlib::Cone::Cone(double minimum, double maximum, bool closed) :
+    Object(),
+    _minimum(minimum),
+    _maximum(maximum),
+    _closed(closed)
+{}
+
+double rtlib::Cone::minimum() const {
+    return _minimum;
+}
+
+double rtlib::Cone::maximum() const {
+    return _maximum;
+}
+
+bool rtlib::Cone::closed() const {
+    return _closed;
+}
+
+rtlib::Intersections rtlib::Cone::intersectsImpl(const Ray& ray) const {
+    const auto origin = ray.origin();
+    const auto direction = ray.direction();
+    Intersections hits;
+    
+    auto addWallHit = [&](double t) {
+        auto y = origin.y() + t * direction.y();
+        if (_minimum < y && y < _maximum) {
+            hits.push_back(Intersect(this, t));
+        }
+    };
+    
+    auto a = direction.x() * direction.x() - direction.y() * direction.y() + direction.z() * direction.z();
+    auto b = 2.0 * (origin.x() * direction.x() - origin.y() * direction.y() + origin.z() * direction.z());
+    auto c = origin.x() * origin.x() - origin.y() * origin.y() + origin.z() * origin.z();
+    
+    if (std::abs(a) > epsilon) {
+        auto discriminant = b * b - 4.0 * a * c;
+        if (discriminant < 0.0) {
+            return hits;
+        }
+        
+        auto root = std::sqrt(discriminant);
+        auto t0 = (-b - root) / (2.0 * a);
+        auto t1 = (-b + root) / (2.0 * a);
+        addWallHit(std::min(t0, t1));
+        addWallHit(std::max(t0, t1));
+    } else if (std::abs(b) > epsilon) {
+        //parallel to one of the halves, so the ray crosses the other once
+        addWallHit(-c / (2.0 * b));
+    }
+    
+    if (_closed && std::abs(direction.y()) > epsilon) {
+        for (auto capY : {_minimum, _maximum}) {
+            auto t = (capY - origin.y()) / direction.y();
+            auto x = origin.x() + t * direction.x();
+            auto z = origin.z() + t * direction.z();
+            if (x * x + z * z <= capY * capY) {
+                hits.push_back(Intersect(this, t));
+            }
+        }
+    }
+    
+    return hits;
+}
+
+rtlib::Tuple rtlib::Cone::normalAtImpl(const Tuple &point) const {
+    auto distance = point.x() * point.x() + point.z() * point.z();
+    
+    if (distance < _maximum * _maximum && point.y() >= _maximum - epsilon) {
+        return create_vector(0.0, 1.0, 0.0);
+    } else if (distance < _minimum * _minimum && point.y() <= _minimum + epsilon) {
+        return create_vector(0.0, -1.0, 0.0);
+    }
+    
+    auto y = std::sqrt(distance);
+    return create_vector(point.x(), point.y() > 0.0 ? -y : y, point.z());
+}
+
+rtlib::BoundingBox rtlib::Cone::localBounds() const {
+    auto radius = std::max(std::abs(_minimum), std::abs(_maximum));
+    return BoundingBox(create_point(-radius, _minimum, -radius), create_point(radius, _maximum, radius));
+}
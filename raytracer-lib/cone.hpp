@@ -0,0 +1,45 @@
+//
+//  cone.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef cone_hpp
+#define cone_hpp
+
+#include "object.hpp"
+#include "ray.hpp"
+
+#include <limits>
+
+namespace rtlib {
+
+//Double napped cone around the y axis with its apex at the origin and a radius
+//equal to |y|, optionally truncated to (minimum, maximum) and capped at those ends.
+class Cone : public Object {
+private:
+    double _minimum;
+    double _maximum;
+    bool _closed;
+    
+public:
+    Cone(double minimum = -std::numeric_limits<double>::infinity(),
+         double maximum = std::numeric_limits<double>::infinity(),
+         bool closed = false);
+    virtual ~Cone() {}
+    
+    double minimum() const;
+    double maximum() const;
+    bool closed() const;
+    
+    virtual BoundingBox localBounds() const;
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const;
+    virtual Tuple normalAtImpl(const Tuple& point) const;
+};
+
+}
+
+#endif /* cone_hpp */
@@ -0,0 +1,283 @@
+//
+//  csg.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "csg.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+
+using namespace rtlib;
+
+namespace {
+
+void sortHits(Intersections& hits) {
+    std::sort(hits.begin(), hits.end(), [](const Intersect& a, const Intersect& b) {
+        return a.t < b.t;
+    });
+}
+
+class Walk;
+
+//one child's boundaries in t order, the child isn't intersected until the first is asked for
+class Boundaries {
+private:
+    const Object* _object;
+    Ray _ray; //in the child's parent space
+    bool _skipped;
+    bool _started;
+    std::optional<Intersect> _current;
+    Intersections _hits;
+    std::size_t _next;
+    std::unique_ptr<Walk> _walk; //for a nested csg
+    
+public:
+    Boundaries(const Object* object, const Ray& ray, bool skipped);
+    ~Boundaries();
+    
+    const Intersect* peek();
+    void pop();
+};
+
+//a csg's kept boundaries in t order, pulled from its children only as far as needed
+class Walk {
+private:
+    CSG::Operation _operation;
+    Boundaries _left;
+    Boundaries _right;
+    bool _insideLeft;
+    bool _insideRight;
+    
+public:
+    Walk(const CSG& csg, const Ray& ray);
+    
+    std::optional<Intersect> next();
+};
+
+Boundaries::Boundaries(const Object* object, const Ray& ray, bool skipped) :
+    _object(object),
+    _ray(ray),
+    _skipped(skipped),
+    _started(false),
+    _next(0)
+{
+}
+
+Boundaries::~Boundaries() {}
+
+const Intersect* Boundaries::peek() {
+    if (_current) {
+        return &*_current;
+    }
+    
+    if (!_started) {
+        _started = true;
+        if (_skipped) {
+            return nullptr;
+        }
+        
+        if (const auto* csg = dynamic_cast<const CSG*>(_object)) {
+            _walk = std::make_unique<Walk>(*csg, _ray.transform(csg->transformAt(_ray.time()).inverse()));
+        } else {
+            _hits = _object->intersects(_ray);
+            sortHits(_hits);
+        }
+    }
+    
+    if (_walk) {
+        _current = _walk->next();
+    } else if (_next < _hits.size()) {
+        _current = _hits[_next++];
+    }
+    
+    return _current ? &*_current : nullptr;
+}
+
+void Boundaries::pop() {
+    _current.reset();
+}
+
+//a child whose bounds the ray misses can't contribute, and only children ahead of the
+//origin matter as intervals behind it close before reaching t = 0
+//a nested csg's bounds also move with its own children
+bool unchanged(const Object* child, unsigned int version) {
+    if (child->transformVersion() != version) {
+        return false;
+    }
+    
+    const auto* csg = dynamic_cast<const CSG*>(child);
+    return !csg || csg->childrenUnchanged();
+}
+
+bool missed(const RayBoxTest& test, const BoundingBox& bounds) {
+    return !test.intersects(bounds, std::numeric_limits<double>::infinity());
+}
+
+Walk::Walk(const CSG& csg, const Ray& ray) :
+    _operation(csg.operation()),
+    _left(csg.left(), ray, missed(RayBoxTest(ray), csg.leftBounds())),
+    _right(csg.right(), ray, missed(RayBoxTest(ray), csg.rightBounds())),
+    _insideLeft(false),
+    _insideRight(false)
+{
+}
+
+std::optional<Intersect> Walk::next() {
+    while (true) {
+        //once past a child's last boundary the ray is outside it for good, which ends
+        //any operation that needs to be inside that child, left first so a right child
+        //is never intersected when the left one rules everything out
+        const auto* left = _left.peek();
+        if (!left && _operation != CSG::Operation::Union) {
+            return std::nullopt;
+        }
+        
+        const auto* right = _right.peek();
+        if (!right && (!left || _operation == CSG::Operation::Intersection)) {
+            return std::nullopt;
+        }
+        
+        auto leftHit = !right || (left && left->t < right->t);
+        auto hit = leftHit ? *left : *right;
+        auto allowed = CSG::intersectionAllowed(_operation, leftHit, _insideLeft, _insideRight);
+        
+        if (leftHit) {
+            _left.pop();
+            _insideLeft = !_insideLeft;
+        } else {
+            _right.pop();
+            _insideRight = !_insideRight;
+        }
+        
+        if (allowed) {
+            return hit;
+        }
+    }
+}
+
+}
+
+CSG::CSG(Operation operation, std::unique_ptr<Object> left, std::unique_ptr<Object> right) :
+    Object(),
+    _operation(operation),
+    _left(std::move(left)),
+    _right(std::move(right))
+{
+    _left->setParent(this);
+    _right->setParent(this);
+    
+    _leftBounds = _left->bounds();
+    _rightBounds = _right->bounds();
+    _leftVersion = _left->transformVersion();
+    _rightVersion = _right->transformVersion();
+}
+
+CSG::Operation CSG::operation() const {
+    return _operation;
+}
+
+const Object* CSG::left() const {
+    return _left.get();
+}
+
+const Object* CSG::right() const {
+    return _right.get();
+}
+
+BoundingBox CSG::leftBounds() const {
+    return unchanged(_left.get(), _leftVersion) ? _leftBounds : _left->bounds();
+}
+
+BoundingBox CSG::rightBounds() const {
+    return unchanged(_right.get(), _rightVersion) ? _rightBounds : _right->bounds();
+}
+
+bool CSG::childrenUnchanged() const {
+    return unchanged(_left.get(), _leftVersion) && unchanged(_right.get(), _rightVersion);
+}
+
+std::vector<Material> CSG::materials() const {
+    //hits always land on a child, the csg's own material is never reported
+    auto all = _left->materials();
+    auto right = _right->materials();
+    all.insert(all.end(), right.begin(), right.end());
+    return all;
+}
+
+bool CSG::intersectionAllowed(Operation operation, bool leftHit, bool insideLeft, bool insideRight) {
+    switch (operation) {
+        case Operation::Union:
+            return (leftHit && !insideRight) || (!leftHit && !insideLeft);
+        
+        case Operation::Intersection:
+            return (leftHit && insideRight) || (!leftHit && insideLeft);
+        
+        case Operation::Difference:
+            return (leftHit && !insideRight) || (!leftHit && insideLeft);
+    }
+    
+    return false;
+}
+
+BoundingBox CSG::localBounds() const {
+    auto left = leftBounds();
+    auto right = rightBounds();
+    
+    switch (_operation) {
+        case Operation::Union:
+            left.addBox(right);
+            return left;
+        
+        case Operation::Intersection: {
+            if (left.empty() || right.empty()) {
+                return BoundingBox();
+            }
+            
+            auto min = create_point(std::max(left.min().x(), right.min().x()),
+                                    std::max(left.min().y(), right.min().y()),
+                                    std::max(left.min().z(), right.min().z()));
+            auto max = create_point(std::min(left.max().x(), right.max().x()),
+                                    std::min(left.max().y(), right.max().y()),
+                                    std::min(left.max().z(), right.max().z()));
+            return BoundingBox(min, max);
+        }
+        
+        case Operation::Difference:
+            return left;
+    }
+    
+    return left;
+}
+
+Intersections CSG::intersectsImpl(const Ray& ray) const {
+    Intersections hits;
+    Walk walk(*this, ray);
+    while (auto hit = walk.next()) {
+        hits.push_back(*hit);
+    }
+    
+    return hits;
+}
+
+Intersections CSG::intersectsToFirstHitImpl(const Ray& ray) const {
+    //boundaries behind the origin still go in for the refraction containers
+    Intersections hits;
+    Walk walk(*this, ray);
+    while (auto hit = walk.next()) {
+        hits.push_back(*hit);
+        if (hit->t >= 0.0) {
+            break;
+        }
+    }
+    
+    return hits;
+}
+
+Tuple CSG::normalAtImpl(const Tuple& point) const {
+    throw std::logic_error("csg hits refer to the child objects, ask them for normals");
+}
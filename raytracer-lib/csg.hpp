@@ -0,0 +1,68 @@
+//
+//  csg.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef csg_hpp
+#define csg_hpp
+
+#include "object.hpp"
+#include "ray.hpp"
+
+#include <memory>
+
+namespace rtlib {
+
+//Constructive solid geometry combining two child objects. The children's boundaries
+//are walked together in t order, tracking whether the ray is inside each child, and
+//only boundaries allowed by the operation are kept. A child is only intersected once
+//the walk reaches it and nested CSGs are walked the same way, so a closest hit query
+//stops at the first kept boundary without finding the rest. Hits refer to the child
+//shapes, so normals and materials come from whichever child was struck.
+class CSG : public Object {
+public:
+    enum class Operation {
+        Union,
+        Intersection,
+        Difference
+    };
+    
+private:
+    Operation _operation;
+    std::unique_ptr<Object> _left;
+    std::unique_ptr<Object> _right;
+    
+    //every ray tests the children's bounds, so they are transformed once when the csg is
+    //made. Children moved afterwards, at any depth, fall back to working them out per ray
+    BoundingBox _leftBounds;
+    BoundingBox _rightBounds;
+    unsigned int _leftVersion;
+    unsigned int _rightVersion;
+    
+public:
+    CSG(Operation operation, std::unique_ptr<Object> left, std::unique_ptr<Object> right);
+    virtual ~CSG() {}
+    
+    Operation operation() const;
+    const Object* left() const;
+    const Object* right() const;
+    BoundingBox leftBounds() const; //in the csg's space
+    BoundingBox rightBounds() const;
+    bool childrenUnchanged() const; //no child, or nested child, moved since the csg was made
+    
+    static bool intersectionAllowed(Operation operation, bool leftHit, bool insideLeft, bool insideRight);
+    
+    virtual BoundingBox localBounds() const;
+    virtual std::vector<Material> materials() const;
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const;
+    virtual Intersections intersectsToFirstHitImpl(const Ray& ray) const;
+    virtual Tuple normalAtImpl(const Tuple& point) const;
+};
+
+}
+
+#endif /* csg_hpp */
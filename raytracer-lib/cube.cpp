@@ -0,0 +1,52 @@
+//
+//  cube.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "cube.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <simd/simd.h>
+
+rtlib::Intersections rtlib::Cube::intersectsImpl(const Ray& ray) const {
+    auto origin = simd_make_double3(ray.origin().x(), ray.origin().y(), ray.origin().z());
+    auto direction = simd_make_double3(ray.direction().x(), ray.direction().y(), ray.direction().z());
+    
+    //all three slabs at once, a zero direction gives infinite distances which the min/max absorb
+    auto inverseDirection = 1.0 / direction;
+    auto t1 = (-1.0 - origin) * inverseDirection;
+    auto t2 = (1.0 - origin) * inverseDirection;
+    auto tMin = simd_reduce_max(simd_min(t1, t2));
+    auto tMax = simd_reduce_min(simd_max(t1, t2));
+    
+    if (tMin > tMax) {
+        return Intersections();
+    }
+    
+    Intersections hits;
+    hits.push_back(Intersect(this, tMin));
+    hits.push_back(Intersect(this, tMax));
+    return hits;
+}
+
+rtlib::Tuple rtlib::Cube::normalAtImpl(const Tuple &point) const {
+    auto x = std::abs(point.x());
+    auto y = std::abs(point.y());
+    auto z = std::abs(point.z());
+    auto maxComponent = std::max({x, y, z});
+    
+    if (maxComponent == x) {
+        return create_vector(point.x(), 0.0, 0.0);
+    } else if (maxComponent == y) {
+        return create_vector(0.0, point.y(), 0.0);
+    }
+    
+    return create_vector(0.0, 0.0, point.z());
+}
+
+rtlib::BoundingBox rtlib::Cube::localBounds() const {
+    return BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0));
+}
@@ -0,0 +1,31 @@
+//
+//  cube.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef cube_hpp
+#define cube_hpp
+
+#include "object.hpp"
+#include "ray.hpp"
+
+namespace rtlib {
+
+//Axis aligned cube from -1 to 1 on every axis, intersected with a slab test.
+class Cube : public Object {
+public:
+    Cube() : Object() {}
+    virtual ~Cube() {}
+    
+    virtual BoundingBox localBounds() const;
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const;
+    virtual Tuple normalAtImpl(const Tuple& point) const;
+};
+
+}
+
+#endif /* cube_hpp */
@@ -0,0 +1,95 @@
+//
+//  cylinder.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "cylinder.hpp"
+
+#include <cmath>
+
+namespace {
+
+const double epsilon = 0.00001;
+
+}
+
+rtlib::Cylinder::Cylinder(double minimum, double maximum, bool closed) :
+    Object(),
+    _minimum(minimum),
+    _maximum(maximum),
+    _closed(closed)
+{}
+
+double rtlib::Cylinder::minimum() const {
+    return _minimum;
+}
+
+double rtlib::Cylinder::maximum() const {
+    return _maximum;
+}
+
+bool rtlib::Cylinder::closed() const {
+    return _closed;
+}
+
+rtlib::Intersections rtlib::Cylinder::intersectsImpl(const Ray& ray) const {
+    const auto origin = ray.origin();
+    const auto direction = ray.direction();
+    Intersections hits;
+    
+    //the walls are the quadratic of a circle in xz, rays parallel to the axis only meet the caps
+    auto a = direction.x() * direction.x() + direction.z() * direction.z();
+    if (a > epsilon) {
+        auto b = 2.0 * (origin.x() * direction.x() + origin.z() * direction.z());
+        auto c = origin.x() * origin.x() + origin.z() * origin.z() - 1.0;
+        auto discriminant = b * b - 4.0 * a * c;
+        if (discriminant < 0.0) {
+            return hits;
+        }
+        
+        auto root = std::sqrt(discriminant);
+        auto t0 = (-b - root) / (2.0 * a);
+        auto t1 = (-b + root) / (2.0 * a);
+        
+        auto y0 = origin.y() + t0 * direction.y();
+        if (_minimum < y0 && y0 < _maximum) {
+            hits.push_back(Intersect(this, t0));
+        }
+        
+        auto y1 = origin.y() + t1 * direction.y();
+        if (_minimum < y1 && y1 < _maximum) {
+            hits.push_back(Intersect(this, t1));
+        }
+    }
+    
+    if (_closed && std::abs(direction.y()) > epsilon) {
+        for (auto capY : {_minimum, _maximum}) {
+            auto t = (capY - origin.y()) / direction.y();
+            auto x = origin.x() + t * direction.x();
+            auto z = origin.z() + t * direction.z();
+            if (x * x + z * z <= 1.0) {
+                hits.push_back(Intersect(this, t));
+            }
+        }
+    }
+    
+    return hits;
+}
+
+rtlib::Tuple rtlib::Cylinder::normalAtImpl(const Tuple &point) const {
+    auto distance = point.x() * point.x() + point.z() * point.z();
+    
+    if (distance < 1.0 && point.y() >= _maximum - epsilon) {
+        return create_vector(0.0, 1.0, 0.0);
+    } else if (distance < 1.0 && point.y() <= _minimum + epsilon) {
+        return create_vector(0.0, -1.0, 0.0);
+    }
+    
+    return create_vector(point.x(), 0.0, point.z());
+}
+
+rtlib::BoundingBox rtlib::Cylinder::localBounds() const {
+    return BoundingBox(create_point(-1.0, _minimum, -1.0), create_point(1.0, _maximum, 1.0));
+}
@@ -0,0 +1,45 @@
+//
+//  cylinder.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef cylinder_hpp
+#define cylinder_hpp
+
+#include "object.hpp"
+#include "ray.hpp"
+
+#include <limits>
+
+namespace rtlib {
+
+//Unit radius cylinder around the y axis, optionally truncated to (minimum, maximum)
+//and capped at those ends.
+class Cylinder : public Object {
+private:
+    double _minimum;
+    double _maximum;
+    bool _closed;
+    
+public:
+    Cylinder(double minimum = -std::numeric_limits<double>::infinity(),
+             double maximum = std::numeric_limits<double>::infinity(),
+             bool closed = false);
+    virtual ~Cylinder() {}
+    
+    double minimum() const;
+    double maximum() const;
+    bool closed() const;
+    
+    virtual BoundingBox localBounds() const;
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const;
+    virtual Tuple normalAtImpl(const Tuple& point) const;
+};
+
+}
+
+#endif /* cylinder_hpp */
@@ -0,0 +1,369 @@
+//
+//  deferred_renderer.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "deferred_renderer.hpp"
+
+#include "intersection.hpp"
+#include "lighting.hpp"
+#include "object.hpp"
+#include "world.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <simd/simd.h>
+#include <stdexcept>
+#include <tuple>
+
+using namespace rtlib;
+
+namespace {
+
+const unsigned int lanes = 4;
+
+//the g-buffer is padded by lanes - 1 entries after sorting so a batch can always be loaded
+inline simd_double4 load(const std::vector<double>& values, unsigned int first) {
+    return *reinterpret_cast<const simd_packed_double4*>(values.data() + first);
+}
+
+//spreads the low 10 bits of value out to every third bit
+uint32_t spreadBits(uint32_t value) {
+    value &= 0x3ff;
+    value = (value | (value << 16)) & 0x030000ff;
+    value = (value | (value << 8)) & 0x0300f00f;
+    value = (value | (value << 4)) & 0x030c30c3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+}
+
+uint32_t quantise(double value, double lower, double extent) {
+    return extent > 0.0 ? static_cast<uint32_t>(std::min(1023.0, (value - lower) / extent * 1024.0)) : 0;
+}
+
+template <typename T>
+void permute(std::vector<T>& values, const std::vector<unsigned int>& order) {
+    std::vector<T> sorted;
+    sorted.reserve(order.size() + lanes - 1);
+    for (auto index : order) {
+        sorted.push_back(values[index]);
+    }
+    
+    values = std::move(sorted);
+}
+
+}
+
+void DeferredRenderer::RayBatch::push(const Ray& ray, unsigned int pixel, double weight, unsigned int depth) {
+    rays.push_back(ray);
+    pixels.push_back(pixel);
+    weights.push_back(weight);
+    remaining.push_back(depth);
+}
+
+void DeferredRenderer::RayBatch::clear() {
+    rays.clear();
+    pixels.clear();
+    weights.clear();
+    remaining.clear();
+}
+
+void DeferredRenderer::RayBatch::sortForCoherence() {
+    //origins are placed on a 1024 cube grid over the batch's own bounds
+    auto lower = create_point(std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+    auto upper = create_point(-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity());
+    for (const auto& ray : rays) {
+        for (unsigned int axis = 0; axis < 3; axis++) {
+            lower.set(axis, std::min(lower[axis], ray.origin()[axis]));
+            upper.set(axis, std::max(upper[axis], ray.origin()[axis]));
+        }
+    }
+    
+    std::vector<uint64_t> keys(rays.size());
+    for (unsigned int i = 0; i < rays.size(); i++) {
+        auto origin = rays[i].origin();
+        auto direction = rays[i].direction();
+        uint64_t octant = (direction.x() < 0.0 ? 1 : 0) | (direction.y() < 0.0 ? 2 : 0) | (direction.z() < 0.0 ? 4 : 0);
+        uint64_t morton = 0;
+        for (unsigned int axis = 0; axis < 3; axis++) {
+            morton |= spreadBits(quantise(origin[axis], lower[axis], upper[axis] - lower[axis])) << axis;
+        }
+        
+        keys[i] = (octant << 30) | morton;
+    }
+    
+    std::vector<unsigned int> order(rays.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](unsigned int a, unsigned int b) {
+        return keys[a] < keys[b];
+    });
+    
+    permute(rays, order);
+    permute(pixels, order);
+    permute(weights, order);
+    permute(remaining, order);
+}
+
+unsigned int DeferredRenderer::GBuffer::size() const {
+    return static_cast<unsigned int>(pixels.size());
+}
+
+void DeferredRenderer::GBuffer::clear() {
+    for (auto* values : {&t, &pointX, &pointY, &pointZ, &normalX, &normalY, &normalZ, &eyeX, &eyeY, &eyeZ,
+                         &red, &green, &blue, &ambient, &diffuse, &specular, &shininess, &visibility, &weight}) {
+        values->clear();
+    }
+    
+    objects.clear();
+    pixels.clear();
+}
+
+void DeferredRenderer::GBuffer::sortByMaterial() {
+    //the shading parameters are the material as far as the kernel is concerned, colour varies per lane
+    std::vector<unsigned int> order(size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](unsigned int a, unsigned int b) {
+        return std::tie(shininess[a], specular[a], diffuse[a], ambient[a]) < std::tie(shininess[b], specular[b], diffuse[b], ambient[b]);
+    });
+    
+    for (auto* values : {&t, &pointX, &pointY, &pointZ, &normalX, &normalY, &normalZ, &eyeX, &eyeY, &eyeZ,
+                         &red, &green, &blue, &ambient, &diffuse, &specular, &shininess, &visibility, &weight}) {
+        permute(*values, order);
+        values->resize(order.size() + lanes - 1, 0.0);
+    }
+    
+    permute(objects, order);
+    permute(pixels, order);
+}
+
+DeferredRenderer::DeferredRenderer(const World& world, const Camera& camera) :
+    DeferredRenderer(world, camera, Settings())
+{
+}
+
+DeferredRenderer::DeferredRenderer(const World& world, const Camera& camera, Settings settings) :
+    _world(world),
+    _camera(camera),
+    _settings(settings)
+{
+    if (_settings.tileSize == 0) {
+        throw std::invalid_argument("tiles must be at least one pixel");
+    }
+}
+
+const DeferredRenderer::Settings& DeferredRenderer::settings() const {
+    return _settings;
+}
+
+DeferredRenderer::TileStats DeferredRenderer::renderTile(Canvas& canvas, unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd) const {
+    if (_world.lights().size() != 1) {
+        throw std::runtime_error("only 1 light supported");
+    }
+    
+    const auto& light = *_world.lights().front();
+    auto width = xEnd - xStart;
+    std::vector<Colour> colours(width * (yEnd - yStart));
+    
+    Camera::TileRays primary;
+    _camera.raysForTile(xStart, yStart, xEnd, yEnd, primary);
+    
+    RayBatch rays;
+    for (unsigned int i = 0; i < primary.size(); i++) {
+        rays.push(primary.ray(i), i, 1.0, _settings.maxDepth);
+    }
+    
+    TileStats stats;
+    std::vector<unsigned int> candidates;
+    auto culled = _settings.frustumCulling && !_world.bvh();
+    if (culled) {
+        candidates = _world.objectsInFrustum(_camera.tileFrustum(xStart, yStart, xEnd, yEnd));
+        stats.candidates = static_cast<unsigned int>(candidates.size());
+    }
+    
+    GBuffer gbuffer;
+    RayBatch next;
+    while (!rays.rays.empty()) {
+        gbuffer.clear();
+        next.clear();
+        
+        //secondary rays leave the frustum so they see the whole world
+        trace(rays, light, gbuffer, next, culled && stats.waves == 0 ? &candidates : nullptr);
+        stats.waves++;
+        stats.hits += gbuffer.size();
+        stats.batches += shade(gbuffer, light, colours);
+        
+        if (_settings.sortSecondaryRays) {
+            next.sortForCoherence();
+        }
+        
+        std::swap(rays, next);
+    }
+    
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = xStart; x < xEnd; x++) {
+            canvas.writePixel(x, y, colours[(y - yStart) * width + (x - xStart)]);
+        }
+    }
+    
+    return stats;
+}
+
+void DeferredRenderer::render(Canvas& canvas) const {
+    auto width = _camera.horizontalSize();
+    auto height = _camera.verticalSize();
+    auto size = _settings.tileSize;
+    
+    for (unsigned int y = 0; y < height; y += size) {
+        for (unsigned int x = 0; x < width; x += size) {
+            renderTile(canvas, x, y, std::min(x + size, width), std::min(y + size, height));
+        }
+    }
+}
+
+void DeferredRenderer::trace(const RayBatch& rays, const Light& light, GBuffer& gbuffer, RayBatch& next, const std::vector<unsigned int>* candidates) const {
+    const auto* compiled = _world.compiledScene();
+    
+    for (unsigned int i = 0; i < rays.rays.size(); i++) {
+        auto values = candidates ? _world.hitValuesAt(rays.rays[i], *candidates) : _world.hitValuesAt(rays.rays[i]);
+        if (!values) {
+            continue;
+        }
+        
+        const auto* object = values->intersect.object;
+        auto material = object->materialAt(values->intersect);
+        auto colour = compiled ? compiled->colourAt(values->intersect, values->point) : material.colourAt(object, values->point, values->intersect.time);
+        
+        gbuffer.objects.push_back(object);
+        gbuffer.t.push_back(values->intersect.t);
+        gbuffer.pointX.push_back(values->point.x());
+        gbuffer.pointY.push_back(values->point.y());
+        gbuffer.pointZ.push_back(values->point.z());
+        gbuffer.normalX.push_back(values->normal.x());
+        gbuffer.normalY.push_back(values->normal.y());
+        gbuffer.normalZ.push_back(values->normal.z());
+        gbuffer.eyeX.push_back(values->vectorToEye.x());
+        gbuffer.eyeY.push_back(values->vectorToEye.y());
+        gbuffer.eyeZ.push_back(values->vectorToEye.z());
+        gbuffer.red.push_back(colour.red());
+        gbuffer.green.push_back(colour.green());
+        gbuffer.blue.push_back(colour.blue());
+        gbuffer.ambient.push_back(material._ambient);
+        gbuffer.diffuse.push_back(material._diffuse);
+        gbuffer.specular.push_back(material._specular);
+        gbuffer.shininess.push_back(material._shininess);
+        gbuffer.visibility.push_back(_world.lightVisibility(light, values->overPoint, values->intersect.time));
+        gbuffer.weight.push_back(rays.weights[i]);
+        gbuffer.pixels.push_back(rays.pixels[i]);
+        
+        //same weights and depths as Integrator::colourAt, refraction doesn't use up a level
+        auto remaining = rays.remaining[i];
+        if (remaining == 0) {
+            continue;
+        }
+        
+        auto reflectWeight = material._reflective;
+        auto refractWeight = material._transparency;
+        if (reflectWeight > 0.0 && refractWeight > 0.0) {
+            auto reflectance = schlickReflectance(*values);
+            reflectWeight *= reflectance;
+            refractWeight *= 1.0 - reflectance;
+        }
+        
+        if (refractWeight > 0.0) {
+            auto refractRay = refractedRay(*values);
+            if (refractRay) {
+                next.push(*refractRay, rays.pixels[i], rays.weights[i] * refractWeight, remaining);
+            }
+        }
+        
+        if (reflectWeight > 0.0) {
+            next.push(Ray(values->overPoint, values->reflectionVector(), values->intersect.time), rays.pixels[i], rays.weights[i] * reflectWeight, remaining - 1);
+        }
+    }
+}
+
+unsigned int DeferredRenderer::shade(GBuffer& gbuffer, const Light& light, std::vector<Colour>& colours) const {
+    auto size = gbuffer.size();
+    if (size == 0) {
+        return 0;
+    }
+    
+    gbuffer.sortByMaterial();
+    
+    unsigned int batches = 0;
+    unsigned int first = 0;
+    while (first < size) {
+        auto end = first + 1;
+        while (end < size && gbuffer.shininess[end] == gbuffer.shininess[first] && gbuffer.specular[end] == gbuffer.specular[first] &&
+               gbuffer.diffuse[end] == gbuffer.diffuse[first] && gbuffer.ambient[end] == gbuffer.ambient[first]) {
+            end++;
+        }
+        
+        shadeBatch(gbuffer, first, end, light, colours);
+        batches++;
+        first = end;
+    }
+    
+    return batches;
+}
+
+void DeferredRenderer::shadeBatch(const GBuffer& gbuffer, unsigned int first, unsigned int end, const Light& light, std::vector<Colour>& colours) const {
+    //Light::lightPoint four hits at a time, the material is uniform across the batch
+    const auto position = light.origin();
+    const auto intensity = light.intensity();
+    const auto ambient = gbuffer.ambient[first];
+    const auto diffuse = gbuffer.diffuse[first];
+    const auto specular = gbuffer.specular[first];
+    const auto shininess = gbuffer.shininess[first];
+    const auto zero = simd_make_double4(0.0, 0.0, 0.0, 0.0);
+    
+    for (unsigned int i = first; i < end; i += lanes) {
+        auto lightX = position.x() - load(gbuffer.pointX, i);
+        auto lightY = position.y() - load(gbuffer.pointY, i);
+        auto lightZ = position.z() - load(gbuffer.pointZ, i);
+        auto length = simd::sqrt(lightX * lightX + lightY * lightY + lightZ * lightZ);
+        lightX /= length;
+        lightY /= length;
+        lightZ /= length;
+        
+        auto normalX = load(gbuffer.normalX, i);
+        auto normalY = load(gbuffer.normalY, i);
+        auto normalZ = load(gbuffer.normalZ, i);
+        auto lightDotNormal = lightX * normalX + lightY * normalY + lightZ * normalZ;
+        
+        //reflecting the vector from the light, -l - n * 2 * dot(-l, n)
+        auto reflectX = normalX * 2.0 * lightDotNormal - lightX;
+        auto reflectY = normalY * 2.0 * lightDotNormal - lightY;
+        auto reflectZ = normalZ * 2.0 * lightDotNormal - lightZ;
+        auto reflectDotEye = reflectX * load(gbuffer.eyeX, i) + reflectY * load(gbuffer.eyeY, i) + reflectZ * load(gbuffer.eyeZ, i);
+        
+        //no light reaches surfaces facing away from it, lanes past the end are never written
+        auto count = std::min(lanes, end - i);
+        auto diffuseFactor = simd_max(lightDotNormal, zero) * diffuse;
+        auto specularFactor = zero;
+        for (unsigned int lane = 0; lane < count; lane++) {
+            if (lightDotNormal[lane] >= 0.0 && reflectDotEye[lane] > 0.0) {
+                specularFactor[lane] = specular * std::pow(reflectDotEye[lane], shininess);
+            }
+        }
+        
+        auto visibility = load(gbuffer.visibility, i);
+        auto weight = load(gbuffer.weight, i);
+        auto red = load(gbuffer.red, i) * intensity.red();
+        auto green = load(gbuffer.green, i) * intensity.green();
+        auto blue = load(gbuffer.blue, i) * intensity.blue();
+        
+        red = (red * ambient + red * diffuseFactor * visibility + intensity.red() * specularFactor * visibility) * weight;
+        green = (green * ambient + green * diffuseFactor * visibility + intensity.green() * specularFactor * visibility) * weight;
+        blue = (blue * ambient + blue * diffuseFactor * visibility + intensity.blue() * specularFactor * visibility) * weight;
+        
+        for (unsigned int lane = 0; lane < count; lane++) {
+            auto& colour = colours[gbuffer.pixels[i + lane]];
+            colour = colour + Colour(red[lane], green[lane], blue[lane]);
+        }
+    }
+}
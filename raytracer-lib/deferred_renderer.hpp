@@ -0,0 +1,101 @@
+//
+//  deferred_renderer.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef deferred_renderer_hpp
+#define deferred_renderer_hpp
+
+#include "camera.hpp"
+#include "canvas.hpp"
+
+#include <vector>
+
+namespace rtlib {
+
+class Light;
+class Object;
+class World;
+
+//Renders a tile at a time with intersection and shading split apart. Every ray in a
+//wave is traced first and its hit written to a G-buffer in SoA form, along with its
+//shadow visibility and any reflected or refracted rays, which make up the next wave.
+//The G-buffer is then sorted by the material's shading parameters and shaded with the
+//Phong model in simd batches, each batch sharing one material. Results match
+//Integrator::colourAt with no contribution threshold, summed in a different order.
+//
+//Secondary rays can be sorted before they're traced, by direction octant and then the
+//Morton code of their origin, so neighbouring rays walk the same parts of the BVH.
+//
+//Without a BVH each tile's primary rays can be frustum culled, only testing the objects
+//whose bounds reach into the pyramid from the camera through the tile's edges.
+class DeferredRenderer {
+public:
+    struct Settings {
+        unsigned int tileSize = 16;
+        unsigned int maxDepth = 5; //as the remaining bounces for Integrator::colourAt
+        bool sortSecondaryRays = false;
+        bool frustumCulling = true; //a BVH already skips what the tile can't see, so only without one
+    };
+    
+    struct TileStats {
+        unsigned int hits = 0;
+        unsigned int batches = 0; //runs of hits sharing a material, over every wave
+        unsigned int waves = 0; //the primary rays then each generation of secondary rays
+        unsigned int candidates = 0; //objects left for the primary rays, 0 when the tile wasn't culled
+    };
+    
+private:
+    struct RayBatch {
+        std::vector<Ray> rays;
+        std::vector<unsigned int> pixels; //index into the tile
+        std::vector<double> weights;
+        std::vector<unsigned int> remaining;
+        
+        void push(const Ray& ray, unsigned int pixel, double weight, unsigned int depth);
+        void clear();
+        void sortForCoherence();
+    };
+    
+    struct GBuffer {
+        std::vector<const Object*> objects;
+        std::vector<double> t;
+        std::vector<double> pointX, pointY, pointZ;
+        std::vector<double> normalX, normalY, normalZ;
+        std::vector<double> eyeX, eyeY, eyeZ;
+        std::vector<double> red, green, blue; //surface colour after patterns
+        std::vector<double> ambient, diffuse, specular, shininess;
+        std::vector<double> visibility;
+        std::vector<double> weight;
+        std::vector<unsigned int> pixels;
+        
+        unsigned int size() const;
+        void clear();
+        void sortByMaterial();
+    };
+    
+    const World& _world;
+    const Camera& _camera;
+    Settings _settings;
+    
+public:
+    DeferredRenderer(const World& world, const Camera& camera);
+    DeferredRenderer(const World& world, const Camera& camera, Settings settings);
+    
+    const Settings& settings() const;
+    
+    //tiles share nothing, so separate tiles can render on separate threads
+    TileStats renderTile(Canvas& canvas, unsigned int xStart, unsigned int yStart, unsigned int xEnd, unsigned int yEnd) const;
+    void render(Canvas& canvas) const;
+    
+private:
+    void trace(const RayBatch& rays, const Light& light, GBuffer& gbuffer, RayBatch& next, const std::vector<unsigned int>* candidates) const;
+    unsigned int shade(GBuffer& gbuffer, const Light& light, std::vector<Colour>& colours) const;
+    void shadeBatch(const GBuffer& gbuffer, unsigned int first, unsigned int end, const Light& light, std::vector<Colour>& colours) const;
+};
+
+}
+
+#endif /* deferred_renderer_hpp */
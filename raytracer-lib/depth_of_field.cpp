@@ -0,0 +1,103 @@
+//
+//  depth_of_field.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "depth_of_field.hpp"
+
+#include "intersection.hpp"
+#include "world.hpp"
+
+#include <stdexcept>
+
+using namespace rtlib;
+
+DepthOfFieldRenderer::DepthOfFieldRenderer(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler) :
+    DepthOfFieldRenderer(world, camera, std::move(sampler), Settings())
+{
+}
+
+DepthOfFieldRenderer::DepthOfFieldRenderer(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler, Settings settings) :
+    _camera(camera),
+    _sampler(std::move(sampler)),
+    _settings(settings),
+    _integrator(world, world.features())
+{
+    if (_settings.lensStrata == 0 || (_settings.adaptive && _settings.probeStrata == 0)) {
+        throw std::invalid_argument("depth of field needs at least one lens stratum");
+    }
+}
+
+const DepthOfFieldRenderer::Settings& DepthOfFieldRenderer::settings() const {
+    return _settings;
+}
+
+DepthOfFieldRenderer::Stats DepthOfFieldRenderer::accumulate(AccumulationBuffer& buffer) const {
+    return accumulate(buffer, 0, buffer.height());
+}
+
+DepthOfFieldRenderer::Stats DepthOfFieldRenderer::accumulate(AccumulationBuffer& buffer, unsigned int yStart, unsigned int yEnd) const {
+    Stats stats;
+    
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = 0; x < buffer.width(); x++) {
+            auto before = buffer.sampleCount(x, y);
+            if (_settings.adaptive && probe(buffer, x, y)) {
+                stats.pixelsInFocus++;
+            } else {
+                //the probe's samples are as good as any others, so they stay in the pixel
+                addStrata(buffer, x, y, _settings.lensStrata);
+                stats.pixelsRefined++;
+            }
+            
+            stats.lensSamples += buffer.sampleCount(x, y) - before;
+        }
+    }
+    
+    return stats;
+}
+
+Ray DepthOfFieldRenderer::lensRay(unsigned int x, unsigned int y, unsigned int index, unsigned int stratum, unsigned int strata) const {
+    auto offset = _sampler->sample2D(x, y, index, 0);
+    auto jitter = _sampler->sample2D(x, y, index, 2);
+    auto lensU = (static_cast<double>(stratum % strata) + jitter[0]) / strata;
+    auto lensV = (static_cast<double>(stratum / strata) + jitter[1]) / strata;
+    
+    auto ray = _camera.rayForPixel(x, y, offset[0], offset[1], lensU, lensV);
+    if (_camera.hasMotionBlur()) {
+        ray.setTime(_camera.shutterTime(_sampler->sample(x, y, index, 4)));
+    }
+    
+    return ray;
+}
+
+bool DepthOfFieldRenderer::probe(AccumulationBuffer& buffer, unsigned int x, unsigned int y) const {
+    auto strata = _settings.probeStrata;
+    auto first = buffer.sampleCount(x, y);
+    const Object* object = nullptr;
+    bool converged = true;
+    
+    for (unsigned int stratum = 0; stratum < strata * strata; stratum++) {
+        //the integrator hands back the hit it shaded rather than the ray being traced twice
+        std::optional<IntersectValues> values;
+        buffer.addSample(x, y, _integrator.colourAt(lensRay(x, y, first + stratum, stratum, strata), _settings.maxDepth, values));
+        auto hit = values ? values->intersect.object : nullptr;
+        if (stratum == 0) {
+            object = hit;
+        }
+        
+        //rays that all miss see the same background
+        converged = converged && hit == object && (!values || _camera.circleOfConfusion(values->point) <= _settings.focusTolerance);
+    }
+    
+    return converged;
+}
+
+void DepthOfFieldRenderer::addStrata(AccumulationBuffer& buffer, unsigned int x, unsigned int y, unsigned int strata) const {
+    auto first = buffer.sampleCount(x, y);
+    for (unsigned int stratum = 0; stratum < strata * strata; stratum++) {
+        buffer.addSample(x, y, _integrator.colourAt(lensRay(x, y, first + stratum, stratum, strata), _settings.maxDepth));
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  depth_of_field.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef depth_of_field_hpp
+#define depth_of_field_hpp
+
+#include "accumulation_buffer.hpp"
+#include "camera.hpp"
+#include "integrator.hpp"
+#include "sampler.hpp"
+
+#include <memory>
+
+namespace rtlib {
+
+class World;
+
+//Whitted rendering through a thin lens camera, where the lens is the only thing being
+//sampled. Lens samples are stratified over the aperture, an n x n grid on the unit
+//square jittered by the sampler and mapped to the disk with equal area strata, and
+//each is added to the pixel in an AccumulationBuffer.
+//
+//In adaptive mode each pixel first traces a small probe grid. When every probe ray
+//hits the same object, with its circle of confusion there under the tolerance, the
+//lens samples have converged on one hit and the probe is all the pixel gets; the rest
+//go to pixels that are out of focus or cross an edge.
+class DepthOfFieldRenderer {
+public:
+    struct Settings {
+        unsigned int lensStrata = 4; //per side, so 16 lens samples for a pixel out of focus
+        unsigned int probeStrata = 2; //per side of the adaptive probe
+        double focusTolerance = 0.5; //circle of confusion in pixels that still counts as one hit
+        bool adaptive = true;
+        unsigned int maxDepth = 5;
+    };
+    
+    struct Stats {
+        unsigned long long lensSamples = 0;
+        unsigned int pixelsInFocus = 0; //settled by the probe alone
+        unsigned int pixelsRefined = 0;
+    };
+    
+private:
+    const Camera& _camera;
+    std::shared_ptr<const Sampler> _sampler;
+    Settings _settings;
+    Integrator _integrator;
+    
+public:
+    DepthOfFieldRenderer(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler);
+    DepthOfFieldRenderer(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler, Settings settings);
+    
+    const Settings& settings() const;
+    
+    //rows can be split across threads, repeated passes carry on along each pixel's samples
+    Stats accumulate(AccumulationBuffer& buffer) const;
+    Stats accumulate(AccumulationBuffer& buffer, unsigned int yStart, unsigned int yEnd) const;
+    
+private:
+    Ray lensRay(unsigned int x, unsigned int y, unsigned int index, unsigned int stratum, unsigned int strata) const;
+    bool probe(AccumulationBuffer& buffer, unsigned int x, unsigned int y) const; //true when the probe rays converge
+    void addStrata(AccumulationBuffer& buffer, unsigned int x, unsigned int y, unsigned int strata) const;
+};
+
+}
+
+#endif /* depth_of_field_hpp */
@@ -0,0 +1,35 @@
+//
+//  disk.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "disk.hpp"
+
+#include "plane.hpp"
+
+rtlib::Intersections rtlib::Disk::intersectsImpl(const Ray& ray) const {
+    double t;
+    if (!Plane::localIntersects(ray, t)) {
+        return Intersections();
+    }
+    
+    auto x = ray.origin().x() + t * ray.direction().x();
+    auto z = ray.origin().z() + t * ray.direction().z();
+    if (x * x + z * z > 1.0) {
+        return Intersections();
+    }
+    
+    Intersections hits;
+    hits.push_back(Intersect(this, t));
+    return hits;
+}
+
+rtlib::Tuple rtlib::Disk::normalAtImpl(const Tuple &point) const {
+    return create_vector(0.0, 1.0, 0.0);
+}
+
+rtlib::BoundingBox rtlib::Disk::localBounds() const {
+    return BoundingBox(create_point(-1.0, 0.0, -1.0), create_point(1.0, 0.0, 1.0));
+}
@@ -0,0 +1,31 @@
+//
+//  disk.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef disk_hpp
+#define disk_hpp
+
+#include "object.hpp"
+#include "ray.hpp"
+
+namespace rtlib {
+
+//Unit radius disk lying in the xz plane, facing up the y axis.
+class Disk : public Object {
+public:
+    Disk() : Object() {}
+    virtual ~Disk() {}
+    
+    virtual BoundingBox localBounds() const;
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const;
+    virtual Tuple normalAtImpl(const Tuple& point) const;
+};
+
+}
+
+#endif /* disk_hpp */
@@ -0,0 +1,187 @@
+//
+//  integrator.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "integrator.hpp"
+
+#include "intersection.hpp"
+#include "object.hpp"
+#include "world.hpp"
+
+#include <vector>
+
+using namespace rtlib;
+
+namespace {
+
+//fixed storage for the usual depths, deeper chains spill over rather than being dropped
+class PendingStack {
+private:
+    std::array<Integrator::PendingRay, Integrator::maxPendingRays> _fixed;
+    unsigned int _size = 0;
+    std::vector<Integrator::PendingRay> _overflow; //only used once _fixed is full
+    
+public:
+    bool empty() const {
+        return _size == 0;
+    }
+    
+    void push(const Integrator::PendingRay& ray) {
+        if (_size < _fixed.size()) {
+            _fixed[_size++] = ray;
+        } else {
+            _overflow.push_back(ray);
+        }
+    }
+    
+    Integrator::PendingRay pop() {
+        if (!_overflow.empty()) {
+            auto ray = _overflow.back();
+            _overflow.pop_back();
+            return ray;
+        }
+        
+        return _fixed[--_size];
+    }
+};
+
+}
+
+Integrator::Integrator(const World& world, double minContribution, bool russianRoulette) :
+    Integrator(world, world.features(), minContribution, russianRoulette)
+{
+}
+
+Integrator::Integrator(const World& world, SceneFeatures features, double minContribution, bool russianRoulette) :
+    _world(world),
+    _minContribution(minContribution),
+    _russianRoulette(russianRoulette),
+    _features(features)
+{
+    if (features.reflection && features.transparency) {
+        _kernel = features.patterns ? &Integrator::trace<true, true, true> : &Integrator::trace<true, true, false>;
+    } else if (features.reflection) {
+        _kernel = features.patterns ? &Integrator::trace<true, false, true> : &Integrator::trace<true, false, false>;
+    } else if (features.transparency) {
+        _kernel = features.patterns ? &Integrator::trace<false, true, true> : &Integrator::trace<false, true, false>;
+    } else {
+        _kernel = features.patterns ? &Integrator::trace<false, false, true> : &Integrator::trace<false, false, false>;
+    }
+}
+
+double Integrator::minContribution() const {
+    return _minContribution;
+}
+
+bool Integrator::russianRoulette() const {
+    return _russianRoulette;
+}
+
+bool Integrator::survives(double& weight) const {
+    if (weight <= 0.0) {
+        return false;
+    } else if (weight >= _minContribution) {
+        return true;
+    } else if (!_russianRoulette) {
+        return false;
+    }
+    
+    auto survival = weight / _minContribution;
+    if (std::uniform_real_distribution<double>(0.0, 1.0)(_random) >= survival) {
+        return false;
+    }
+    
+    weight = _minContribution;
+    return true;
+}
+
+const SceneFeatures& Integrator::features() const {
+    return _features;
+}
+
+Colour Integrator::colourAt(const Ray& ray, unsigned int remaining) const {
+    return (this->*_kernel)(ray, remaining, nullptr);
+}
+
+Colour Integrator::colourAt(const Ray& ray, unsigned int remaining, std::optional<IntersectValues>& primary) const {
+    return (this->*_kernel)(ray, remaining, &primary);
+}
+
+template <bool Reflection, bool Transparency, bool Patterns>
+Colour Integrator::trace(const Ray& ray, unsigned int remaining, std::optional<IntersectValues>* primary) const {
+    if constexpr (!Reflection && !Transparency) {
+        //opaque scenes never spawn rays, one hit and done
+        auto values = _world.hitValuesAt(ray);
+        if (primary) {
+            *primary = values;
+        }
+        if (!values) {
+            return Colour();
+        }
+        
+        if constexpr (Patterns) {
+            return _world.surfaceColourAt(*values);
+        } else {
+            auto material = values->intersect.object->materialAt(values->intersect);
+            return _world.surfaceColourAt(*values, material, material._colour);
+        }
+    } else {
+        PendingStack stack;
+        stack.push({ray, 1.0, remaining});
+        
+        Colour colour;
+        while (!stack.empty()) {
+            auto pending = stack.pop();
+            auto values = _world.hitValuesAt(pending.ray);
+            if (primary) {
+                //the first ray popped is the one passed in
+                *primary = values;
+                primary = nullptr;
+            }
+            if (!values) {
+                continue;
+            }
+            
+            auto material = values->intersect.object->materialAt(values->intersect);
+            if constexpr (Patterns) {
+                colour = colour + _world.surfaceColourAt(*values) * pending.weight;
+            } else {
+                colour = colour + _world.surfaceColourAt(*values, material, material._colour) * pending.weight;
+            }
+            
+            //same weights and depths as World::shadeHits, refraction doesn't use up a level
+            auto reflectWeight = Reflection ? material._reflective : 0.0;
+            auto refractWeight = Transparency ? material._transparency : 0.0;
+            if constexpr (Reflection && Transparency) {
+                if (reflectWeight > 0.0 && refractWeight > 0.0) {
+                    auto reflectance = schlickReflectance(*values);
+                    reflectWeight *= reflectance;
+                    refractWeight *= 1.0 - reflectance;
+                }
+            }
+            
+            //weights are tested before the ray is built so dim rays cost nothing
+            if constexpr (Transparency) {
+                refractWeight *= pending.weight;
+                if (pending.remaining > 0 && survives(refractWeight)) {
+                    auto refractRay = refractedRay(*values);
+                    if (refractRay) {
+                        stack.push({*refractRay, refractWeight, pending.remaining});
+                    }
+                }
+            }
+            
+            if constexpr (Reflection) {
+                reflectWeight *= pending.weight;
+                if (pending.remaining > 0 && survives(reflectWeight)) {
+                    stack.push({Ray(values->overPoint, values->reflectionVector(), values->intersect.time), reflectWeight, pending.remaining - 1});
+                }
+            }
+        }
+        
+        return colour;
+    }
+}
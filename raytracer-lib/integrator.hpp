@@ -0,0 +1,73 @@
+//
+//  integrator.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef integrator_hpp
+#define integrator_hpp
+
+#include "colour.hpp"
+#include "ray.hpp"
+#include "world.hpp"
+
+#include <array>
+#include <optional>
+#include <random>
+
+namespace rtlib {
+
+//Whitted style integrator that follows reflection and refraction without recursion.
+//A hit's colour is its direct lighting plus weighted reflected and refracted colours,
+//so each pending ray carries the product of the weights above it and adds its own
+//direct lighting straight into the pixel.
+class Integrator {
+public:
+    struct PendingRay {
+        Ray ray;
+        double weight;
+        unsigned int remaining;
+    };
+    
+    //depth first, so this only fills up along long chains of refraction which don't
+    //use up the recursion depth, or a large remaining. Rays past it spill to the heap
+    static const unsigned int maxPendingRays = 64;
+    
+private:
+    typedef Colour (Integrator::*Kernel)(const Ray& ray, unsigned int remaining, std::optional<IntersectValues>* primary) const;
+    
+    const World& _world;
+    double _minContribution;
+    bool _russianRoulette;
+    SceneFeatures _features;
+    Kernel _kernel;
+    mutable std::minstd_rand _random; //one integrator per thread
+    
+public:
+    //rays whose weight falls below minContribution are dropped, or with russian roulette
+    //kept with probability weight / minContribution and boosted to stay unbiased
+    Integrator(const World& world, double minContribution = 0.0, bool russianRoulette = false);
+    
+    //the kernel is picked from the features once here, a world edited afterwards to use
+    //more features needs a new integrator
+    Integrator(const World& world, SceneFeatures features, double minContribution = 0.0, bool russianRoulette = false);
+    
+    double minContribution() const;
+    bool russianRoulette() const;
+    const SceneFeatures& features() const;
+    
+    Colour colourAt(const Ray& ray, unsigned int remaining = 5) const;
+    //also hands back the ray's own hit, for callers that need where it landed as well
+    Colour colourAt(const Ray& ray, unsigned int remaining, std::optional<IntersectValues>& primary) const;
+    
+private:
+    template <bool Reflection, bool Transparency, bool Patterns>
+    Colour trace(const Ray& ray, unsigned int remaining, std::optional<IntersectValues>* primary) const;
+    
+    bool survives(double& weight) const;
+};
+
+}
+
+#endif /* integrator_hpp */
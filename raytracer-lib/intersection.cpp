@@ -9,15 +9,17 @@
 
 #include "object.hpp"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 
 using namespace rtlib;
 
-Intersect::Intersect(const Object* obj, double t_) :
-object(obj), t(t_) {}
+Intersect::Intersect(const Object* obj, double t_, unsigned int primitive_, double time_) :
+object(obj), t(t_), primitive(primitive_), time(time_), entry(noEntry) {}
 
 bool Intersect::operator==(const Intersect& rhs) const {
-    return this->object == rhs.object && this->t == rhs.t;
+    return this->object == rhs.object && this->t == rhs.t && this->primitive == rhs.primitive;
 }
 
 IntersectValues::IntersectValues(Intersect intersect, Ray ray) :
@@ -26,60 +28,94 @@ IntersectValues(intersect, ray, Intersections({intersect}))
 }
 
 IntersectValues::IntersectValues(Intersect intersect, Ray ray, const Intersections& intersections) :
+IntersectValues(intersect, ray, intersections, intersect.object->normalAt(ray.positionAt(intersect.t), Intersect(intersect.object, intersect.t, intersect.primitive, ray.time())))
+{
+}
+
+IntersectValues::IntersectValues(Intersect intersect, Ray ray, const Intersections& intersections, const Tuple& surfaceNormal) :
     intersect(intersect)
 {
+    this->intersect.time = ray.time();
     point = ray.positionAt(intersect.t);
     vectorToEye = -ray.direction();
-    normal = intersect.object->normalAt(point);
+    normal = surfaceNormal;
     
     if (Tuple::dot(vectorToEye, normal) < 0) {
         inside = true;
-        normal = -intersect.object->normalAt(point);
+        normal = -normal;
     } else {
         inside = false;
     }
     
     auto epsilonPoint = normal * 0.0000001;
     overPoint = point + epsilonPoint;
-    underPoint = point - epsilonPoint;
     
-    reflectionVector = Tuple::reflect(ray.direction(), normal);
+    //most hits are opaque, only refraction needs the under point and the container walk
+    if (intersect.object->materialAt(intersect)._transparency == 0.0) {
+        underPoint = overPoint;
+        return;
+    }
+    
+    underPoint = point - epsilonPoint;
     
     auto firstHit = getFirstHit(intersections);
     if (!firstHit) {
         return;
     }
     
-    std::vector<const Object*> containers;
+    //containers are tracked per primitive so the spheres of a sphere set nest like separate objects,
+    //shells nested deeper than the fixed stack holds move it to the heap
+    constexpr unsigned int maxContainers = 32;
+    std::array<const Intersect*, maxContainers> fixedContainers;
+    std::vector<const Intersect*> spilledContainers;
+    const Intersect** containers = fixedContainers.data();
+    unsigned int containerCapacity = maxContainers;
+    unsigned int containerCount = 0;
     
-    for (auto it : intersections) {
+    auto refractiveIndexOf = [&]() {
+        if (containerCount == 0) {
+            return 1.0;
+        }
+        
+        auto container = containers[containerCount - 1];
+        return container->object->materialAt(*container)._refractiveIndex;
+    };
+    
+    for (const auto& it : intersections) {
         if (it == intersect) {
-            if (containers.empty()) {
-                refractiveIndexN1 = 1.0;
-            } else {
-                refractiveIndexN1 = containers.back()->material()._refractiveIndex;
-            }
+            refractiveIndexN1 = refractiveIndexOf();
         }
         
-        auto existingPos = std::find(containers.begin(), containers.end(), it.object);
-        if (existingPos != containers.end()) {
-            containers.erase(existingPos);
+        auto existingPos = std::find_if(containers, containers + containerCount, [&it](const Intersect* container) {
+            return container->object == it.object && container->primitive == it.primitive;
+        });
+        if (existingPos != containers + containerCount) {
+            std::copy(existingPos + 1, containers + containerCount, existingPos);
+            containerCount--;
         } else {
-            containers.push_back(it.object);
+            if (containerCount == containerCapacity) {
+                if (spilledContainers.empty()) {
+                    spilledContainers.assign(fixedContainers.begin(), fixedContainers.end());
+                }
+                containerCapacity *= 2;
+                spilledContainers.resize(containerCapacity);
+                containers = spilledContainers.data();
+            }
+            containers[containerCount++] = &it;
         }
         
         if (it == intersect) {
-            if (containers.empty()) {
-                refractiveIndexN2 = 1.0;
-            } else {
-                refractiveIndexN2 = containers.back()->material()._refractiveIndex;
-            }
-            
+            refractiveIndexN2 = refractiveIndexOf();
             break;
         }
     }
 }
 
+Tuple IntersectValues::reflectionVector() const {
+    auto direction = vectorToEye;
+    return Tuple::reflect(-direction, normal);
+}
+
 std::optional<Intersect> rtlib::getFirstHit(rtlib::Intersections hits) {
     std::optional<Intersect> result;
     
@@ -114,3 +150,17 @@ double rtlib::schlickReflectance(const IntersectValues &values) {
     
     return r0 + ((1.0 - r0) * std::pow(1 - cosine, 5.0));
 }
+
+std::optional<Ray> rtlib::refractedRay(const IntersectValues& values) {
+    //snells law to determine total internal refraction
+    auto nRatio = values.refractiveIndexN1 / values.refractiveIndexN2;
+    auto cosI = Tuple::dot(values.vectorToEye, values.normal);
+    auto sin2t = nRatio * nRatio * (1 - cosI * cosI);
+    if (sin2t > 1.0) {
+        return std::nullopt;
+    }
+    
+    auto cosT = std::sqrt(1.0 - sin2t);
+    auto direction = values.normal * (nRatio * cosI - cosT) - values.vectorToEye * nRatio;
+    return Ray(values.underPoint, direction, values.intersect.time);
+}
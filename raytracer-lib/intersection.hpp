@@ -21,8 +21,13 @@ class Object;
 struct Intersect {
     const Object* object;
     double t;
+    unsigned int primitive; //which part of the object was hit, for objects made of many primitives
+    double time; //the ray's, so moving objects are shaded where they were when hit
+    unsigned int entry; //the object's index in the compiled scene that found it, or noEntry
     
-    Intersect(const Object* obj, double t_);
+    static constexpr unsigned int noEntry = ~0u;
+    
+    Intersect(const Object* obj, double t_, unsigned int primitive_ = 0, double time_ = 0.0);
     bool operator==(const Intersect& rhs) const;
 };
 typedef std::vector<Intersect> Intersections;
@@ -33,20 +38,23 @@ struct IntersectValues {
     Tuple vectorToEye;
     Tuple normal;
     Tuple overPoint;
-    Tuple underPoint;
-    Tuple reflectionVector;
+    Tuple underPoint; //refraction data, only filled in for transparent materials
     bool inside;
-    double refractiveIndexN1; //material being exited
-    double refractiveIndexN2; //material being entered
+    double refractiveIndexN1 = 1.0; //material being exited
+    double refractiveIndexN2 = 1.0; //material being entered
     
     
     IntersectValues(Intersect intersect, Ray ray);
     IntersectValues(Intersect intersect, Ray ray, const Intersections& intersections);
+    IntersectValues(Intersect intersect, Ray ray, const Intersections& intersections, const Tuple& surfaceNormal);
+    
+    Tuple reflectionVector() const; //worked out on demand, most hits are never reflected
 };
 
 std::optional<Intersect> getFirstHit(Intersections hits);
 
 double schlickReflectance(const IntersectValues& values);
+std::optional<Ray> refractedRay(const IntersectValues& values); //empty under total internal reflection
     
 }
 #endif /* intersection_hpp */
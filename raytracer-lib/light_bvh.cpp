@@ -0,0 +1,184 @@
+//
+//  light_bvh.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "light_bvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rtlib;
+
+namespace {
+
+std::vector<BoundingBox> lightBounds(const std::vector<std::unique_ptr<Light>>& lights) {
+    std::vector<BoundingBox> bounds;
+    bounds.reserve(lights.size());
+    for (const auto& light : lights) {
+        bounds.push_back(light->bounds());
+    }
+    
+    return bounds;
+}
+
+}
+
+LightBVH::LightBVH(const std::vector<std::unique_ptr<Light>>& lights) :
+    _bvh(lightBounds(lights), 1),
+    _lightPower(lights.size()),
+    _lightLeaf(lights.size(), BVH::noNode)
+{
+    for (unsigned int i = 0; i < lights.size(); i++) {
+        _lightPower[i] = std::max(0.0, lights[i]->intensity().luminance());
+    }
+    
+    //children always come after their parent, so summing backwards fills every node
+    const auto& nodes = _bvh.nodes();
+    _nodePower.assign(nodes.size(), 0.0);
+    for (auto node = static_cast<unsigned int>(nodes.size()); node-- > 0;) {
+        if (nodes[node].leaf) {
+            for (unsigned int i = nodes[node].first; i < nodes[node].first + nodes[node].count; i++) {
+                auto light = _bvh.primitives()[i];
+                _nodePower[node] += _lightPower[light];
+                _lightLeaf[light] = node;
+            }
+        } else {
+            _nodePower[node] = _nodePower[nodes[node].left] + _nodePower[nodes[node].right];
+        }
+    }
+}
+
+const BVH& LightBVH::bvh() const {
+    return _bvh;
+}
+
+double LightBVH::power() const {
+    return _bvh.root() == BVH::noNode ? 0.0 : _nodePower[_bvh.root()];
+}
+
+std::optional<LightBVH::LightSample> LightBVH::sample(const Tuple& point, const Tuple& normal, double u) const {
+    auto node = _bvh.root();
+    if (node == BVH::noNode) {
+        return std::nullopt;
+    }
+    
+    const auto& nodes = _bvh.nodes();
+    double pmf = 1.0;
+    
+    //each choice rescales u back to [0, 1) so one number drives the whole walk
+    while (!nodes[node].leaf) {
+        auto left = nodeImportance(nodes[node].left, point, normal);
+        auto right = nodeImportance(nodes[node].right, point, normal);
+        if (left + right <= 0.0) {
+            return std::nullopt;
+        }
+        
+        auto leftProbability = left / (left + right);
+        if (u < leftProbability) {
+            u = std::min(u / leftProbability, 1.0);
+            pmf *= leftProbability;
+            node = nodes[node].left;
+        } else {
+            u = std::min((u - leftProbability) / (1.0 - leftProbability), 1.0);
+            pmf *= 1.0 - leftProbability;
+            node = nodes[node].right;
+        }
+    }
+    
+    const auto& leaf = nodes[node];
+    double total = 0.0;
+    for (unsigned int i = leaf.first; i < leaf.first + leaf.count; i++) {
+        total += lightImportance(_bvh.primitives()[i], point, normal);
+    }
+    
+    if (total <= 0.0) {
+        return std::nullopt;
+    }
+    
+    //walk the leaf's lights, falling back to the last one it could pick if u rounds past the end
+    auto target = u * total;
+    std::optional<LightSample> chosen;
+    for (unsigned int i = leaf.first; i < leaf.first + leaf.count; i++) {
+        auto light = _bvh.primitives()[i];
+        auto weight = lightImportance(light, point, normal);
+        if (weight <= 0.0) {
+            continue;
+        }
+        
+        chosen = LightSample{light, pmf * weight / total};
+        if (target < weight) {
+            break;
+        }
+        target -= weight;
+    }
+    
+    return chosen;
+}
+
+double LightBVH::pmf(const Tuple& point, const Tuple& normal, unsigned int light) const {
+    auto node = _lightLeaf[light];
+    const auto& nodes = _bvh.nodes();
+    
+    double total = 0.0;
+    for (unsigned int i = nodes[node].first; i < nodes[node].first + nodes[node].count; i++) {
+        total += lightImportance(_bvh.primitives()[i], point, normal);
+    }
+    
+    if (total <= 0.0) {
+        return 0.0;
+    }
+    
+    auto pmf = lightImportance(light, point, normal) / total;
+    
+    //the same choices sample() makes, taken from the leaf up
+    for (auto parent = nodes[node].parent; parent != BVH::noNode; node = parent, parent = nodes[node].parent) {
+        auto left = nodeImportance(nodes[parent].left, point, normal);
+        auto right = nodeImportance(nodes[parent].right, point, normal);
+        if (left + right <= 0.0) {
+            return 0.0;
+        }
+        
+        pmf *= (node == nodes[parent].left ? left : right) / (left + right);
+    }
+    
+    return pmf;
+}
+
+double LightBVH::importance(const BoundingBox& bounds, double power, const Tuple& point, const Tuple& normal) {
+    if (power <= 0.0) {
+        return 0.0;
+    }
+    
+    //a cone from the point around the box's bounding sphere, the point may be inside it
+    auto centre = bounds.centroid();
+    auto radius = (bounds.max() - bounds.min()).magnitude() * 0.5;
+    auto toCentre = centre - point;
+    auto distance = toCentre.magnitude();
+    if (distance <= radius) {
+        return power;
+    }
+    
+    auto cosTheta = std::clamp(Tuple::dot(toCentre, normal) / distance, -1.0, 1.0);
+    auto sinAlpha = radius / distance;
+    auto cosAlpha = std::sqrt(1.0 - sinAlpha * sinAlpha);
+    
+    //cosine of the smallest angle between the normal and the cone, cos(max(0, theta - alpha))
+    if (cosTheta >= cosAlpha) {
+        return power;
+    }
+    
+    auto sinTheta = std::sqrt(std::max(0.0, 1.0 - cosTheta * cosTheta));
+    auto cosBound = cosTheta * cosAlpha + sinTheta * sinAlpha;
+    return cosBound > 0.0 ? power * cosBound : 0.0;
+}
+
+double LightBVH::nodeImportance(unsigned int node, const Tuple& point, const Tuple& normal) const {
+    return importance(_bvh.nodes()[node].bounds, _nodePower[node], point, normal);
+}
+
+double LightBVH::lightImportance(unsigned int light, const Tuple& point, const Tuple& normal) const {
+    return importance(_bvh.primitiveBounds(light), _lightPower[light], point, normal);
+}
@@ -0,0 +1,56 @@
+//
+//  light_bvh.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef light_bvh_hpp
+#define light_bvh_hpp
+
+#include "bvh.hpp"
+#include "lighting.hpp"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace rtlib {
+
+//Hierarchy over the lights for picking one in proportion to its estimated contribution,
+//walking a single path from the root so the cost is logarithmic in the light count.
+//Each node's importance is its total power times a bound on the cosine between the
+//receiving normal and any direction into the node's box. Lights here have no distance
+//falloff (see Light::lightPoint), so distance doesn't enter the estimate.
+class LightBVH {
+public:
+    struct LightSample {
+        unsigned int light; //index into the lights the tree was built over
+        double pmf;
+    };
+    
+private:
+    BVH _bvh;
+    std::vector<double> _lightPower;
+    std::vector<double> _nodePower;
+    std::vector<unsigned int> _lightLeaf;
+    
+public:
+    LightBVH(const std::vector<std::unique_ptr<Light>>& lights);
+    
+    const BVH& bvh() const;
+    double power() const;
+    
+    //u in [0, 1), nothing when no light can reach the front of the surface
+    std::optional<LightSample> sample(const Tuple& point, const Tuple& normal, double u) const;
+    double pmf(const Tuple& point, const Tuple& normal, unsigned int light) const;
+    
+private:
+    static double importance(const BoundingBox& bounds, double power, const Tuple& point, const Tuple& normal);
+    double nodeImportance(unsigned int node, const Tuple& point, const Tuple& normal) const;
+    double lightImportance(unsigned int light, const Tuple& point, const Tuple& normal) const;
+};
+
+}
+
+#endif /* light_bvh_hpp */
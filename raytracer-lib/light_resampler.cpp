@@ -0,0 +1,264 @@
+//
+//  light_resampler.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "light_resampler.hpp"
+
+#include "lighting.hpp"
+#include "object.hpp"
+#include "world.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace rtlib;
+
+namespace {
+
+//surfaces closer than this in normal and relative distance share their lighting
+const double similarNormal = 0.9;
+const double similarDistance = 0.1;
+
+}
+
+LightResampler::LightResampler(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler) :
+    LightResampler(world, camera, std::move(sampler), Settings())
+{
+}
+
+LightResampler::LightResampler(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler, Settings settings) :
+    _world(world),
+    _camera(camera),
+    _sampler(std::move(sampler)),
+    _settings(settings),
+    _frame(0),
+    _hasHistory(false),
+    _previousCamera(camera),
+    _surfaces(camera.horizontalSize() * camera.verticalSize()),
+    _candidates(_surfaces.size()),
+    _reservoirs(_surfaces.size())
+{
+    if (_settings.candidates == 0) {
+        throw std::invalid_argument("resampling needs at least one candidate per pixel");
+    }
+    
+    //ambient is added for every light without resampling, it needs no shadow ray
+    for (const auto& light : _world.lights()) {
+        _totalIntensity = _totalIntensity + light->intensity();
+    }
+}
+
+const LightResampler::Settings& LightResampler::settings() const {
+    return _settings;
+}
+
+unsigned int LightResampler::frame() const {
+    return _frame;
+}
+
+const LightResampler::Reservoir& LightResampler::reservoirAt(unsigned int x, unsigned int y) const {
+    return _reservoirs[y * _camera.horizontalSize() + x];
+}
+
+void LightResampler::samplePass(unsigned int yStart, unsigned int yEnd) {
+    const auto width = _camera.horizontalSize();
+    const auto& lights = _world.lights();
+    const auto* lightBvh = _world.lightBvh();
+    const auto temporalDimension = 2 * _settings.candidates;
+    
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            auto& surface = _surfaces[y * width + x];
+            auto& reservoir = _candidates[y * width + x];
+            surface = Surface();
+            reservoir = Reservoir();
+            
+            auto ray = _camera.rayForPixel(x, y);
+            auto values = _world.hitValuesAt(ray);
+            if (!values) {
+                continue;
+            }
+            
+            const auto* object = values->intersect.object;
+            surface.hit = true;
+            surface.point = values->point;
+            surface.overPoint = values->overPoint;
+            surface.normal = values->normal;
+            surface.vectorToEye = values->vectorToEye;
+            surface.material = object->materialAt(values->intersect);
+            surface.colour = _world.compiledScene() ?
+                _world.compiledScene()->colourAt(values->intersect, values->point) :
+                surface.material.colourAt(object, values->point);
+            surface.distance = (values->point - ray.origin()).magnitude();
+            
+            //resampled importance sampling from the cheap source distribution towards the target
+            for (unsigned int i = 0; i < _settings.candidates && !lights.empty(); i++) {
+                auto u = random(x, y, 2 * i);
+                unsigned int light;
+                double pmf;
+                if (lightBvh) {
+                    auto picked = lightBvh->sample(surface.overPoint, surface.normal, u);
+                    if (!picked) {
+                        reservoir.count++;
+                        continue;
+                    }
+                    light = picked->light;
+                    pmf = picked->pmf;
+                } else {
+                    light = std::min(static_cast<unsigned int>(u * lights.size()), static_cast<unsigned int>(lights.size()) - 1);
+                    pmf = 1.0 / lights.size();
+                }
+                
+                auto target = targetFor(surface, light);
+                update(reservoir, light, target / pmf, target, random(x, y, 2 * i + 1));
+            }
+            
+            //the same surface last frame, found by reprojecting through the camera as it was
+            auto previous = _settings.temporalReuse && _hasHistory ? _previousCamera.pixelForPoint(surface.point) : std::nullopt;
+            if (previous) {
+                auto previousIndex = (*previous)[1] * width + (*previous)[0];
+                if (similar(surface, _previousSurfaces[previousIndex])) {
+                    merge(reservoir, surface, _previousReservoirs[previousIndex], _settings.historyLimit * _settings.candidates, random(x, y, temporalDimension));
+                }
+            }
+            
+            finalise(reservoir);
+        }
+    }
+}
+
+void LightResampler::reusePass(unsigned int yStart, unsigned int yEnd) {
+    const auto width = _camera.horizontalSize();
+    const auto height = _camera.verticalSize();
+    const auto radius = static_cast<double>(_settings.spatialRadius);
+    const auto spatialDimension = 2 * _settings.candidates + 1;
+    
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            const auto& surface = _surfaces[y * width + x];
+            auto& reservoir = _reservoirs[y * width + x];
+            reservoir = _candidates[y * width + x];
+            if (!surface.hit) {
+                continue;
+            }
+            
+            for (unsigned int i = 0; i < _settings.spatialNeighbours; i++) {
+                auto dimension = spatialDimension + 3 * i;
+                auto nx = static_cast<int>(x) + static_cast<int>(std::lround((random(x, y, dimension) * 2.0 - 1.0) * radius));
+                auto ny = static_cast<int>(y) + static_cast<int>(std::lround((random(x, y, dimension + 1) * 2.0 - 1.0) * radius));
+                if (nx < 0 || ny < 0 || nx >= static_cast<int>(width) || ny >= static_cast<int>(height) ||
+                    (nx == static_cast<int>(x) && ny == static_cast<int>(y))) {
+                    continue;
+                }
+                
+                auto neighbour = ny * width + nx;
+                if (similar(surface, _surfaces[neighbour])) {
+                    merge(reservoir, surface, _candidates[neighbour], std::numeric_limits<unsigned int>::max(), random(x, y, dimension + 2));
+                }
+            }
+            
+            finalise(reservoir);
+        }
+    }
+}
+
+void LightResampler::shadePass(Canvas& canvas, unsigned int yStart, unsigned int yEnd) const {
+    const auto width = _camera.horizontalSize();
+    const auto shadeDimension = 2 * _settings.candidates + 1 + 3 * _settings.spatialNeighbours;
+    
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        for (unsigned int x = 0; x < width; x++) {
+            const auto& surface = _surfaces[y * width + x];
+            const auto& reservoir = _reservoirs[y * width + x];
+            if (!surface.hit) {
+                canvas.writePixel(x, y, Colour(0.0, 0.0, 0.0));
+                continue;
+            }
+            
+            Colour colour = surface.colour * _totalIntensity * surface.material._ambient;
+            if (reservoir.light != noLight && reservoir.weight > 0.0) {
+                //the single shadow ray, to one of the kept light's sample points
+                const auto& light = *_world.lights()[reservoir.light];
+                auto index = std::min(static_cast<unsigned int>(random(x, y, shadeDimension) * light.sampleCount()), light.sampleCount() - 1);
+                if (!_world.isOccluded(surface.overPoint, light.samplePoint(index, surface.overPoint), light)) {
+                    auto direct = light.directLight(surface.material, surface.colour, surface.point, surface.vectorToEye, surface.normal);
+                    colour = colour + direct * reservoir.weight;
+                }
+            }
+            
+            canvas.writePixel(x, y, colour);
+        }
+    }
+}
+
+void LightResampler::endFrame() {
+    _previousSurfaces = _surfaces;
+    _previousReservoirs = _reservoirs;
+    _previousCamera = _camera;
+    _hasHistory = true;
+    _frame++;
+}
+
+void LightResampler::render(Canvas& canvas) {
+    auto height = _camera.verticalSize();
+    samplePass(0, height);
+    reusePass(0, height);
+    shadePass(canvas, 0, height);
+    endFrame();
+}
+
+void LightResampler::resetHistory() {
+    _hasHistory = false;
+}
+
+double LightResampler::random(unsigned int x, unsigned int y, unsigned int dimension) const {
+    return _sampler->sample(x, y, _frame, dimension);
+}
+
+double LightResampler::targetFor(const Surface& surface, unsigned int light) const {
+    auto direct = _world.lights()[light]->directLight(surface.material, surface.colour, surface.point, surface.vectorToEye, surface.normal);
+    return std::max(0.0, direct.luminance());
+}
+
+bool LightResampler::similar(const Surface& a, const Surface& b) const {
+    return a.hit && b.hit &&
+        Tuple::dot(a.normal, b.normal) >= similarNormal &&
+        std::abs(a.distance - b.distance) <= similarDistance * a.distance;
+}
+
+bool LightResampler::update(Reservoir& reservoir, unsigned int light, double weight, double target, double u) {
+    reservoir.count++;
+    if (weight <= 0.0) {
+        return false;
+    }
+    
+    reservoir.weightSum += weight;
+    if (u * reservoir.weightSum < weight) {
+        reservoir.light = light;
+        reservoir.target = target;
+        return true;
+    }
+    
+    return false;
+}
+
+void LightResampler::merge(Reservoir& reservoir, const Surface& surface, const Reservoir& other, unsigned int countLimit, double u) const {
+    auto count = std::min(other.count, countLimit);
+    if (count == 0) {
+        return;
+    }
+    
+    //the other pixel's light is reweighted by how much it matters here
+    auto target = other.light == noLight ? 0.0 : targetFor(surface, other.light);
+    update(reservoir, other.light, target * other.weight * count, target, u);
+    reservoir.count += count - 1;
+}
+
+void LightResampler::finalise(Reservoir& reservoir) {
+    reservoir.weight = reservoir.target > 0.0 && reservoir.count > 0 ?
+        reservoir.weightSum / (reservoir.count * reservoir.target) : 0.0;
+}
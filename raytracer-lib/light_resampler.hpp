@@ -0,0 +1,110 @@
+//
+//  light_resampler.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef light_resampler_hpp
+#define light_resampler_hpp
+
+#include "camera.hpp"
+#include "canvas.hpp"
+#include "material.hpp"
+#include "sampler.hpp"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace rtlib {
+
+class World;
+
+//Direct lighting from many lights at one shadow ray per pixel, by reservoir based
+//spatiotemporal importance resampling (ReSTIR, Bitterli et al. 2020). Each pixel
+//streams candidate lights through a weighted reservoir, merges in its reservoir from
+//the previous frame and those of nearby pixels, and then shades only the light it
+//kept. Candidates come from the world's LightBVH when it has one, otherwise uniformly.
+//Reuse is the biased form: neighbours are only merged when their surface is similar.
+//
+//A frame is samplePass, reusePass then shadePass, each over row ranges so they can be
+//split across threads. Every row must finish one pass before any row starts the next,
+//and endFrame keeps the frame as history for the next one. The camera may move between
+//frames, history is reprojected through the camera as it was.
+class LightResampler {
+public:
+    static constexpr unsigned int noLight = std::numeric_limits<unsigned int>::max();
+    
+    struct Settings {
+        unsigned int candidates = 32; //initial lights streamed per pixel
+        unsigned int spatialNeighbours = 5;
+        unsigned int spatialRadius = 10; //in pixels
+        unsigned int historyLimit = 20; //caps reused samples at this many times the candidates
+        bool temporalReuse = true;
+    };
+    
+    struct Reservoir {
+        unsigned int light = noLight;
+        double weightSum = 0.0;
+        unsigned int count = 0; //candidates seen, M
+        double target = 0.0; //unshadowed luminance of the kept light here
+        double weight = 0.0; //contribution weight of the kept light, W
+    };
+    
+private:
+    struct Surface {
+        bool hit = false;
+        Tuple point;
+        Tuple overPoint;
+        Tuple normal;
+        Tuple vectorToEye;
+        Material material;
+        Colour colour;
+        double distance = 0.0;
+    };
+    
+    const World& _world;
+    const Camera& _camera;
+    std::shared_ptr<const Sampler> _sampler;
+    Settings _settings;
+    Colour _totalIntensity;
+    
+    unsigned int _frame; //sample index for the sampler, so frames decorrelate
+    bool _hasHistory;
+    Camera _previousCamera;
+    std::vector<Surface> _surfaces;
+    std::vector<Reservoir> _candidates; //after the initial and temporal stages
+    std::vector<Reservoir> _reservoirs; //after spatial reuse, what gets shaded
+    std::vector<Surface> _previousSurfaces;
+    std::vector<Reservoir> _previousReservoirs;
+    
+public:
+    LightResampler(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler);
+    LightResampler(const World& world, const Camera& camera, std::shared_ptr<const Sampler> sampler, Settings settings);
+    
+    const Settings& settings() const;
+    unsigned int frame() const;
+    const Reservoir& reservoirAt(unsigned int x, unsigned int y) const;
+    
+    void samplePass(unsigned int yStart, unsigned int yEnd);
+    void reusePass(unsigned int yStart, unsigned int yEnd);
+    void shadePass(Canvas& canvas, unsigned int yStart, unsigned int yEnd) const;
+    void endFrame();
+    void render(Canvas& canvas);
+    
+    //drop the history, for cuts in the sequence
+    void resetHistory();
+    
+private:
+    double random(unsigned int x, unsigned int y, unsigned int dimension) const;
+    double targetFor(const Surface& surface, unsigned int light) const;
+    bool similar(const Surface& a, const Surface& b) const;
+    static bool update(Reservoir& reservoir, unsigned int light, double weight, double target, double u);
+    void merge(Reservoir& reservoir, const Surface& surface, const Reservoir& other, unsigned int countLimit, double u) const;
+    static void finalise(Reservoir& reservoir);
+};
+
+}
+
+#endif /* light_resampler_hpp */
@@ -25,35 +25,70 @@ rtlib::Colour rtlib::Light::intensity() const {
     return _intensity;
 }
 
+unsigned int rtlib::Light::sampleCount() const {
+    return 1;
+}
+
+unsigned int rtlib::Light::initialSamples() const {
+    return 1;
+}
+
+rtlib::Tuple rtlib::Light::samplePoint(unsigned int index, const Tuple& from) const {
+    return _position;
+}
+
+rtlib::BoundingBox rtlib::Light::bounds() const {
+    return BoundingBox(_position, _position);
+}
+
 rtlib::Colour rtlib::Light::lightPoint(const Object* object, Tuple point, Tuple vectorToCamera, Tuple normal, bool inShadow) const {
-    if (!point.isPoint() || !vectorToCamera.isVector() || !normal.isVector()) {
-        throw std::runtime_error("Incorrect parameters supplied");
+    const auto& material = object->material();
+    return lightPoint(material, material.colourAt(object, point), point, vectorToCamera, normal, inShadow);
+}
+
+rtlib::Colour rtlib::Light::lightPoint(const Material& material, const Colour& surfaceColour, Tuple point, Tuple vectorToCamera, Tuple normal, bool inShadow) const {
+    return lightPoint(material, surfaceColour, point, vectorToCamera, normal, inShadow ? 0.0 : 1.0);
+}
+
+rtlib::Colour rtlib::Light::lightPoint(const Material& material, const Colour& surfaceColour, Tuple point, Tuple vectorToCamera, Tuple normal, double visibility) const {
+    checkShadingParameters(point, vectorToCamera, normal);
+    
+    rtlib::Colour ambient = surfaceColour * this->_intensity * material._ambient;
+    if (visibility <= 0.0) {
+        return ambient;
     }
     
-    rtlib::Colour ambient, diffuse, specular;
+    rtlib::Colour diffuse, specular;
+    unshadowedLight(material, surfaceColour, point, vectorToCamera, normal, diffuse, specular);
+    return ambient + diffuse * visibility + specular * visibility;
+}
+
+rtlib::Colour rtlib::Light::directLight(const Material& material, const Colour& surfaceColour, Tuple point, Tuple vectorToCamera, Tuple normal) const {
+    checkShadingParameters(point, vectorToCamera, normal);
     
-    auto effectiveColour = object->material().colourAt(object, point) * this->_intensity;
+    rtlib::Colour diffuse, specular;
+    unshadowedLight(material, surfaceColour, point, vectorToCamera, normal, diffuse, specular);
+    return diffuse + specular;
+}
+
+void rtlib::Light::checkShadingParameters(const Tuple& point, const Tuple& vectorToCamera, const Tuple& normal) {
+    if (!point.isPoint() || !vectorToCamera.isVector() || !normal.isVector()) {
+        throw std::runtime_error("Incorrect parameters supplied");
+    }
+}
+
+void rtlib::Light::unshadowedLight(const Material& material, const Colour& surfaceColour, const Tuple& point, const Tuple& vectorToCamera, const Tuple& normal, Colour& diffuse, Colour& specular) const {
     auto lightVector = (this->_position - point).normalised();
-    ambient = effectiveColour * object->material()._ambient;
-    
-    if (!inShadow) {
-        auto lightDotNormal = Tuple::dot(lightVector, normal);
-        if (lightDotNormal < 0.0) {
-            diffuse = rtlib::Colour(0, 0, 0);
-            specular = rtlib::Colour(0, 0, 0);
-        } else {
-            diffuse = effectiveColour * object->material()._diffuse * lightDotNormal;
-            auto reflectV = rtlib::Tuple::reflect(-lightVector, normal);
-            auto reflectDotEye = Tuple::dot(reflectV, vectorToCamera);
-            
-            if (reflectDotEye <= 0.0) {
-                specular = rtlib::Colour(0, 0, 0);
-            } else {
-                auto factor = std::pow(reflectDotEye, object->material()._shininess);
-                specular = this->_intensity * object->material()._specular * factor;
-            }
-        }
+    auto lightDotNormal = Tuple::dot(lightVector, normal);
+    if (lightDotNormal < 0.0) {
+        return;
     }
     
-    return ambient + diffuse + specular;
+    diffuse = surfaceColour * this->_intensity * material._diffuse * lightDotNormal;
+    auto reflectV = rtlib::Tuple::reflect(-lightVector, normal);
+    auto reflectDotEye = Tuple::dot(reflectV, vectorToCamera);
+    if (reflectDotEye > 0.0) {
+        auto factor = std::pow(reflectDotEye, material._shininess);
+        specular = this->_intensity * material._specular * factor;
+    }
 }
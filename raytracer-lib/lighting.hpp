@@ -8,6 +8,7 @@
 #ifndef lighting_hpp
 #define lighting_hpp
 
+#include "bounding_box.hpp"
 #include "colour.hpp"
 #include "material.hpp"
 #include "tuple.hpp"
@@ -21,15 +22,48 @@ private:
     
 public:
     Light(const Tuple& origin, const Colour& intensity);
+    virtual ~Light() {}
     
     Tuple origin() const;
     Colour intensity() const;
     
+    //points shadow rays are aimed at, a point light only has its origin. Shadow testing
+    //starts with initialSamples() of them and only continues when those disagree
+    virtual unsigned int sampleCount() const;
+    virtual unsigned int initialSamples() const;
+    virtual Tuple samplePoint(unsigned int index, const Tuple& from) const;
+    
+    //space the light's samples can fall in, for LightBVH
+    virtual BoundingBox bounds() const;
+    
     Colour lightPoint(const Object* object,
                       Tuple point,
                       Tuple vectorToCamera,
                       Tuple normal,
                       bool inShadow) const;
+    Colour lightPoint(const Material& material,
+                      const Colour& surfaceColour,
+                      Tuple point,
+                      Tuple vectorToCamera,
+                      Tuple normal,
+                      bool inShadow) const;
+    //visibility is the fraction of the light reaching the point, scaling diffuse and specular
+    Colour lightPoint(const Material& material,
+                      const Colour& surfaceColour,
+                      Tuple point,
+                      Tuple vectorToCamera,
+                      Tuple normal,
+                      double visibility) const;
+    //diffuse and specular with the light unblocked, what lightPoint scales by visibility
+    Colour directLight(const Material& material,
+                       const Colour& surfaceColour,
+                       Tuple point,
+                       Tuple vectorToCamera,
+                       Tuple normal) const;
+    
+private:
+    static void checkShadingParameters(const Tuple& point, const Tuple& vectorToCamera, const Tuple& normal);
+    void unshadowedLight(const Material& material, const Colour& surfaceColour, const Tuple& point, const Tuple& vectorToCamera, const Tuple& normal, Colour& diffuse, Colour& specular) const;
 };
 
 }
@@ -10,8 +10,12 @@
 using namespace rtlib;
 
 Colour Material::colourAt(const Object* object, Tuple point) const {
+    return colourAt(object, point, 0.0);
+}
+
+Colour Material::colourAt(const Object* object, Tuple point, double time) const {
     if (_pattern) {
-        return _pattern->colourAt(object, point);
+        return _pattern->colourAt(object, point, time);
     } else {
         return _colour;
     }
@@ -29,9 +29,11 @@ public:
     double _reflective = 0.0;
     double _transparency = 0.0;
     double _refractiveIndex = 1.0;
+    Colour _emissive = Colour(0.0, 0.0, 0.0); //only the path integrator treats surfaces as lights
     
 public:
     Colour colourAt(const Object* object, Tuple point) const;
+    Colour colourAt(const Object* object, Tuple point, double time) const;
 };
 
 }
@@ -11,11 +11,31 @@
 #include "ray.hpp"
 #include "tuple.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <numeric>
 
+namespace {
+
+std::atomic<unsigned long long> transformEpochCounter(0);
+
+//hits carry the time so normals and patterns follow the object to where it was
+void stampTime(rtlib::Intersections& hits, std::size_t first, double time) {
+    if (time != 0.0) {
+        for (auto i = first; i < hits.size(); i++) {
+            hits[i].time = time;
+        }
+    }
+}
+
+}
+
 rtlib::Object::Object() :
-    _transform(Matrix4x4::identityMatrix())
+    _transform(Matrix4x4::identityMatrix()),
+    _transformVersion(0),
+    _materialVersion(0),
+    _parent(nullptr)
 {}
 
 rtlib::Matrix4x4 rtlib::Object::transform() const {
@@ -24,9 +44,88 @@ rtlib::Matrix4x4 rtlib::Object::transform() const {
 
 void rtlib::Object::setTransform(rtlib::Matrix4x4 matrix) {
     _transform = matrix;
+    _motion.reset();
+    _transformVersion++;
+    transformEpochCounter++;
+}
+
+void rtlib::Object::setMotion(Matrix4x4 start, Matrix4x4 end) {
+    _transform = start;
+    _motion = Motion{end, decompose(start), decompose(end)};
+    _transformVersion++;
+    transformEpochCounter++;
+}
+
+void rtlib::Object::geometryChanged() {
+    _transformVersion++;
+    transformEpochCounter++;
+}
+
+bool rtlib::Object::isMoving() const {
+    return _motion.has_value();
+}
+
+rtlib::Matrix4x4 rtlib::Object::endTransform() const {
+    return _motion ? _motion->end : _transform;
+}
+
+rtlib::Matrix4x4 rtlib::Object::transformAt(double time) const {
+    if (!_motion || time <= 0.0) {
+        return _transform;
+    } else if (time >= 1.0) {
+        return _motion->end;
+    }
+    
+    return interpolate(_motion->startParts, _motion->endParts, time);
+}
+
+unsigned int rtlib::Object::transformVersion() const {
+    return _transformVersion;
+}
+
+unsigned long long rtlib::Object::transformEpoch() {
+    return transformEpochCounter.load(std::memory_order_relaxed);
+}
+
+const rtlib::Object* rtlib::Object::parent() const {
+    return _parent;
+}
+
+void rtlib::Object::setParent(const Object* parent) {
+    _parent = parent;
+}
+
+rtlib::Tuple rtlib::Object::worldToObject(const Tuple &point) const {
+    return worldToObject(point, 0.0);
+}
+
+rtlib::Tuple rtlib::Object::worldToObject(const Tuple &point, double time) const {
+    if (_parent) {
+        return transformAt(time).inverse() * _parent->worldToObject(point, time);
+    }
+    
+    return transformAt(time).inverse() * point;
+}
+
+rtlib::Tuple rtlib::Object::normalToWorld(const Tuple &normal) const {
+    return normalToWorld(normal, 0.0);
+}
+
+rtlib::Tuple rtlib::Object::normalToWorld(const Tuple &normal, double time) const {
+    auto worldNormal = transformAt(time).inverse().transpose() * normal;
+    worldNormal.setW(0.0);
+    worldNormal = worldNormal.normalised();
+    
+    if (_parent) {
+        return _parent->normalToWorld(worldNormal, time);
+    }
+    
+    return worldNormal;
 }
 
 rtlib::Material& rtlib::Object::material() {
+    //the caller may edit through the reference, so assume it does
+    _materialVersion++;
     return _material;
 }
 
@@ -36,18 +135,100 @@ rtlib::Material rtlib::Object::material() const {
 
 void rtlib::Object::setMaterial(Material material) {
     _material = material;
+    _materialVersion++;
+}
+
+unsigned int rtlib::Object::materialVersion() const {
+    return _materialVersion;
+}
+
+rtlib::Material rtlib::Object::materialAt(const Intersect& hit) const {
+    return _material;
+}
+
+std::vector<rtlib::Material> rtlib::Object::materials() const {
+    return {_material};
 }
 
 rtlib::Intersections rtlib::Object::intersects(const Ray &ray) const {
-    auto localRay = ray.transform(_transform.inverse());
-    return intersectsImpl(localRay);
+    auto localRay = ray.transform(transformAt(ray.time()).inverse());
+    auto hits = intersectsImpl(localRay);
+    stampTime(hits, 0, ray.time());
+    return hits;
+}
+
+rtlib::Intersections rtlib::Object::intersectsToFirstHit(const Ray &ray) const {
+    auto localRay = ray.transform(transformAt(ray.time()).inverse());
+    auto hits = intersectsToFirstHitImpl(localRay);
+    stampTime(hits, 0, ray.time());
+    return hits;
+}
+
+rtlib::Intersections rtlib::Object::intersectsToFirstHitImpl(const Ray &ray) const {
+    return intersectsImpl(ray);
+}
+
+std::vector<rtlib::Object::PrimitiveRange> rtlib::Object::primitiveRanges() const {
+    return {};
+}
+
+void rtlib::Object::intersectsRange(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const {
+    auto localRay = ray.transform(transformAt(ray.time()).inverse());
+    auto start = hits.size();
+    intersectsRangeImpl(localRay, first, count, hits);
+    stampTime(hits, start, ray.time());
+}
+
+void rtlib::Object::intersectsRangeImpl(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const {
+    auto objectHits = intersectsImpl(ray);
+    hits.insert(hits.end(), objectHits.begin(), objectHits.end());
 }
 
 rtlib::Tuple rtlib::Object::normalAt(const Tuple &point) const {
-    auto localPoint = _transform.inverse() * point;
-    auto localNormal = normalAtImpl(localPoint);
-    auto worldNormal = this->transform().inverse().transpose() * localNormal;
-    worldNormal.setW(0.0);
-    return worldNormal.normalised();
+    return normalToWorld(normalAtImpl(worldToObject(point)));
+}
+
+rtlib::Tuple rtlib::Object::normalAt(const Tuple &point, const Intersect& hit) const {
+    return normalToWorld(normalAtImpl(worldToObject(point, hit.time), hit), hit.time);
 }
 
+rtlib::Tuple rtlib::Object::normalAtImpl(const Tuple &point, const Intersect& hit) const {
+    return normalAtImpl(point);
+}
+
+rtlib::BoundingBox rtlib::Object::localBounds() const {
+    return BoundingBox::infinite();
+}
+
+rtlib::BoundingBox rtlib::Object::bounds() const {
+    return worldBounds(localBounds());
+}
+
+rtlib::BoundingBox rtlib::Object::worldBounds(const BoundingBox& local) const {
+    if (!_motion || !local.finite()) {
+        return local.transform(_transform);
+    }
+    
+    //the box at evenly spaced times, grown by how far a corner can bulge out on the
+    //arc between two of them
+    const unsigned int steps = 16;
+    BoundingBox bounds;
+    double reach = 0.0;
+    for (unsigned int step = 0; step <= steps; step++) {
+        auto transform = transformAt(static_cast<double>(step) / steps);
+        auto box = local.transform(transform);
+        bounds.addBox(box);
+        
+        auto origin = transform * create_point(0.0, 0.0, 0.0);
+        for (const auto& corner : {box.min(), box.max()}) {
+            reach = std::max(reach, (corner - origin).magnitude());
+        }
+    }
+    
+    auto angle = rotationAngle(_motion->startParts, _motion->endParts) / steps;
+    auto bulge = reach * (1.0 - std::cos(angle / 2.0));
+    auto pad = create_vector(bulge, bulge, bulge);
+    bounds.addPoint(bounds.min() - pad);
+    bounds.addPoint(bounds.max() + pad);
+    return bounds;
+}
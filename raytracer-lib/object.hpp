@@ -8,9 +8,13 @@
 #ifndef object_hpp
 #define object_hpp
 
+#include "bounding_box.hpp"
 #include "intersection.hpp"
 #include "lighting.hpp"
 #include "matrix.hpp"
+#include "transformations.hpp"
+
+#include <optional>
 
 namespace rtlib {
 
@@ -18,26 +22,80 @@ class Ray;
 
 class Object {
 private:
+    struct Motion {
+        Matrix4x4 end;
+        DecomposedTransform startParts;
+        DecomposedTransform endParts;
+    };
+    
     Matrix4x4 _transform;
+    std::optional<Motion> _motion;
     Material _material;
+    unsigned int _transformVersion;
+    unsigned int _materialVersion;
+    const Object* _parent;
     
 public:
     Object();
     virtual ~Object() {}
     
-    Matrix4x4 transform() const;
+    Matrix4x4 transform() const; //the start transform of a moving object
     void setTransform(Matrix4x4 matrix);
+    unsigned int transformVersion() const; //also bumped when a subclass's geometry changes
+    static unsigned long long transformEpoch(); //bumped by any object's transform change, a cheap check that none moved
+    
+    //moves from start at time 0 to end at time 1 by blending their decomposed parts,
+    //setTransform makes the object static again
+    void setMotion(Matrix4x4 start, Matrix4x4 end);
+    bool isMoving() const;
+    Matrix4x4 endTransform() const;
+    Matrix4x4 transformAt(double time) const; //time is clamped to [0, 1]
+    
+    //objects nested in a composite like CSG are transformed relative to their parent
+    const Object* parent() const;
+    void setParent(const Object* parent);
+    Tuple worldToObject(const Tuple& point) const;
+    Tuple worldToObject(const Tuple& point, double time) const;
+    Tuple normalToWorld(const Tuple& normal) const;
+    Tuple normalToWorld(const Tuple& normal, double time) const;
     
     Material& material();
     Material material() const;
     void setMaterial(Material material);
+    unsigned int materialVersion() const; //bumped by setMaterial and by every non-const material()
+    virtual Material materialAt(const Intersect& hit) const;
+    virtual std::vector<Material> materials() const; //every material a hit on this object can report
     
     Intersections intersects(const Ray& ray) const;
+    //every hit up to and including the first at or past t = 0, all a closest hit or shadow
+    //query needs. Composites can stop looking there, others return all of their hits
+    Intersections intersectsToFirstHit(const Ray& ray) const;
     Tuple normalAt(const Tuple& point) const;
+    Tuple normalAt(const Tuple& point, const Intersect& hit) const;
+    
+    virtual BoundingBox localBounds() const;
+    BoundingBox bounds() const; //covers the whole motion of a moving object
+    
+    //objects made of many primitives can hand a world BVH their own leaves as ranges, so
+    //the ranges are split and traversed along with every other object's bounds
+    struct PrimitiveRange {
+        unsigned int first;
+        unsigned int count;
+        BoundingBox bounds; //world space, over the whole motion like bounds()
+    };
+    
+    virtual std::vector<PrimitiveRange> primitiveRanges() const; //empty when the object is one primitive
+    void intersectsRange(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const;
     
 protected:
+    BoundingBox worldBounds(const BoundingBox& local) const;
+    void geometryChanged(); //for shapes edited in place, BVHs holding them see a move
+
     virtual Intersections intersectsImpl(const Ray& ray) const = 0;
+    virtual Intersections intersectsToFirstHitImpl(const Ray& ray) const;
+    virtual void intersectsRangeImpl(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const;
     virtual Tuple normalAtImpl(const Tuple& point) const = 0;
+    virtual Tuple normalAtImpl(const Tuple& point, const Intersect& hit) const;
 };
 
 }
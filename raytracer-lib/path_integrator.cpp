@@ -0,0 +1,138 @@
+//
+//  path_integrator.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "path_integrator.hpp"
+
+#include "intersection.hpp"
+#include "lighting.hpp"
+#include "object.hpp"
+#include "path_sampling.hpp"
+#include "world.hpp"
+
+using namespace rtlib;
+
+PathIntegrator::PathIntegrator(const World& world, unsigned int maxDepth, unsigned int seed) :
+    _world(world),
+    _maxDepth(maxDepth),
+    _random(seed)
+{
+}
+
+unsigned int PathIntegrator::maxDepth() const {
+    return _maxDepth;
+}
+
+const Sampler* PathIntegrator::sampler() const {
+    return _sampler.get();
+}
+
+void PathIntegrator::setSampler(std::shared_ptr<const Sampler> sampler) {
+    _sampler = std::move(sampler);
+}
+
+double PathIntegrator::uniform() const {
+    if (_cursor.active) {
+        return _sampler->sample(_cursor.x, _cursor.y, _cursor.index, _cursor.dimension++);
+    }
+    
+    return std::uniform_real_distribution<double>(0.0, 1.0)(_random);
+}
+
+Colour PathIntegrator::colourAt(const Ray& cameraRay) const {
+    Colour radiance;
+    Colour throughput(1.0, 1.0, 1.0);
+    auto ray = cameraRay;
+    
+    for (unsigned int depth = 0; depth <= _maxDepth; depth++) {
+        auto values = _world.hitValuesAt(ray);
+        if (!values) {
+            break;
+        }
+        
+        const auto* object = values->intersect.object;
+        auto material = object->materialAt(values->intersect);
+        auto surfaceColour = _world.compiledScene() ?
+            _world.compiledScene()->colourAt(values->intersect, values->point) :
+            material.colourAt(object, values->point, values->intersect.time);
+        
+        radiance = radiance + throughput * material._emissive;
+        
+        //next event estimation, point lights can't be hit by sampled rays so they only come through here
+        auto random = [this]() { return uniform(); };
+        SurfaceLobes lobes(material, surfaceColour);
+        if (!lobes.empty()) {
+            auto lightContribution = [&](const Light& light) {
+                auto target = lightTarget(light, values->overPoint, random);
+                auto direct = unshadowedPathLight(light, target, *values, lobes);
+                if (!direct || _world.isOccluded(values->overPoint, target, light, values->intersect.time)) {
+                    return Colour(0.0, 0.0, 0.0);
+                }
+                
+                return *direct;
+            };
+            
+            if (const auto* lightBvh = _world.lightBvh()) {
+                //one light per hit picked by estimated contribution, weighted by how likely it was
+                auto picked = lightBvh->sample(values->overPoint, values->normal, uniform());
+                if (picked) {
+                    radiance = radiance + throughput * lightContribution(*_world.lights()[picked->light]) * (1.0 / picked->pmf);
+                }
+            } else {
+                for (const auto& light : _world.lights()) {
+                    radiance = radiance + throughput * lightContribution(*light);
+                }
+            }
+        }
+        
+        if (!continuePath(depth, *values, material, lobes, random, throughput, ray)) {
+            break;
+        }
+    }
+    
+    return radiance;
+}
+
+void PathIntegrator::accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel) const {
+    accumulate(camera, buffer, samplesPerPixel, 0, buffer.height());
+}
+
+void PathIntegrator::accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel, unsigned int yStart, unsigned int yEnd) const {
+    for (unsigned int y = yStart; y < yEnd; y++) {
+        accumulateSpan(camera, buffer, samplesPerPixel, {y, 0, buffer.width()});
+    }
+    
+    _cursor.active = false;
+}
+
+void PathIntegrator::accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel, const std::vector<PixelSpan>& spans) const {
+    for (const auto& span : spans) {
+        accumulateSpan(camera, buffer, samplesPerPixel, span);
+    }
+    
+    _cursor.active = false;
+}
+
+void PathIntegrator::accumulateSpan(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel, const PixelSpan& span) const {
+    auto y = span.y;
+    for (auto x = span.xStart; x < span.xEnd; x++) {
+        for (unsigned int sample = 0; sample < samplesPerPixel; sample++) {
+            //later passes carry on along the pixel's sequence rather than repeating it
+            _cursor = {_sampler != nullptr, x, y, buffer.sampleCount(x, y), 0};
+            auto offsetX = uniform();
+            auto offsetY = uniform();
+            //the lens and shutter only take dimensions when they're used, so other renders keep their sequence
+            auto lensU = camera.isPinhole() ? 0.5 : uniform();
+            auto lensV = camera.isPinhole() ? 0.5 : uniform();
+            auto ray = camera.rayForPixel(x, y, offsetX, offsetY, lensU, lensV);
+            if (camera.hasMotionBlur()) {
+                ray.setTime(camera.shutterTime(uniform()));
+            }
+            
+            buffer.addSample(x, y, colourAt(ray));
+        }
+    }
+}
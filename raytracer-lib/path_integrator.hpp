@@ -0,0 +1,75 @@
+//
+//  path_integrator.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef path_integrator_hpp
+#define path_integrator_hpp
+
+#include "accumulation_buffer.hpp"
+#include "camera.hpp"
+#include "colour.hpp"
+#include "ray.hpp"
+#include "region.hpp"
+#include "sampler.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace rtlib {
+
+class World;
+
+//Monte Carlo path tracer over the same materials as the Whitted integrator.
+//Every hit adds next event estimation to each Light plus any _emissive colour, then
+//continues along one of its lobes: the diffuse and phong lobes are sampled as a
+//mixture weighted with the balance heuristic, while mirror reflection and refraction
+//are picked with probability proportional to their weights. Ambient is left out as
+//the indirect bounces replace it.
+class PathIntegrator {
+private:
+    const World& _world;
+    unsigned int _maxDepth;
+    mutable std::minstd_rand _random; //one integrator per thread
+    
+    //when accumulating with a sampler each random number is the next dimension of the pixel's sample
+    std::shared_ptr<const Sampler> _sampler;
+    struct SampleCursor {
+        bool active = false;
+        unsigned int x;
+        unsigned int y;
+        unsigned int index;
+        unsigned int dimension;
+    };
+    mutable SampleCursor _cursor;
+    
+public:
+    PathIntegrator(const World& world, unsigned int maxDepth = 8, unsigned int seed = 1);
+    
+    unsigned int maxDepth() const;
+    
+    const Sampler* sampler() const;
+    void setSampler(std::shared_ptr<const Sampler> sampler);
+    
+    //one sample of the light arriving along the ray
+    Colour colourAt(const Ray& ray) const;
+    
+    //adds samplesPerPixel jittered samples to each pixel of rows [yStart, yEnd),
+    //passes can be repeated until the image is clean enough
+    void accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel = 1) const;
+    void accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel, unsigned int yStart, unsigned int yEnd) const;
+    
+    //only the spans' pixels, each getting the samples a full frame pass would give it
+    void accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel, const std::vector<PixelSpan>& spans) const;
+    
+private:
+    double uniform() const;
+    void accumulateSpan(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel, const PixelSpan& span) const;
+};
+
+}
+
+#endif /* path_integrator_hpp */
@@ -0,0 +1,72 @@
+//
+//  path_sampling.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "path_sampling.hpp"
+
+using namespace rtlib;
+
+double rtlib::maxComponent(const Colour& colour) {
+    return std::max({colour.red(), colour.green(), colour.blue()});
+}
+
+Tuple rtlib::aroundAxis(const Tuple& axis, double x, double y, double z) {
+    auto sign = std::copysign(1.0, axis.z());
+    auto a = -1.0 / (sign + axis.z());
+    auto b = axis.x() * axis.y() * a;
+    auto tangent = create_vector(1.0 + sign * axis.x() * axis.x() * a, sign * b, -sign * axis.x());
+    auto bitangent = create_vector(b, sign + axis.y() * axis.y() * a, -axis.y());
+    return tangent * x + bitangent * y + axis * z;
+}
+
+SurfaceLobes::SurfaceLobes(const Material& material, const Colour& surfaceColour) :
+    diffuse(surfaceColour * material._diffuse),
+    specular(material._specular),
+    shininess(material._shininess)
+{
+    auto diffuseWeight = diffuse.luminance();
+    diffuseProbability = diffuseWeight + specular > 0.0 ? diffuseWeight / (diffuseWeight + specular) : 0.0;
+}
+
+bool SurfaceLobes::empty() const {
+    return diffuseProbability == 0.0 && specular == 0.0;
+}
+
+Colour SurfaceLobes::evaluate(const Tuple& toEye, const Tuple& toLight, const Tuple& normal) const {
+    Colour result = diffuse * (1.0 / std::numbers::pi);
+    if (specular > 0.0) {
+        auto cosAlpha = Tuple::dot(Tuple::reflect(toEye * -1.0, normal), toLight);
+        if (cosAlpha > 0.0) {
+            auto factor = specular * (shininess + 2.0) / (2.0 * std::numbers::pi) * std::pow(cosAlpha, shininess);
+            result = result + Colour(factor, factor, factor);
+        }
+    }
+    
+    return result;
+}
+
+double SurfaceLobes::pdf(const Tuple& toEye, const Tuple& direction, const Tuple& normal) const {
+    auto cosTheta = std::max(0.0, Tuple::dot(direction, normal));
+    auto result = diffuseProbability * cosTheta / std::numbers::pi;
+    
+    auto cosAlpha = Tuple::dot(Tuple::reflect(toEye * -1.0, normal), direction);
+    if (cosAlpha > 0.0) {
+        result += (1.0 - diffuseProbability) * (shininess + 1.0) / (2.0 * std::numbers::pi) * std::pow(cosAlpha, shininess);
+    }
+    
+    return result;
+}
+
+std::optional<Colour> rtlib::unshadowedPathLight(const Light& light, const Tuple& target, const IntersectValues& values, const SurfaceLobes& lobes) {
+    auto toLight = (target - values.overPoint).normalised();
+    auto cosTheta = Tuple::dot(toLight, values.normal);
+    if (cosTheta <= 0.0) {
+        return std::nullopt;
+    }
+    
+    auto f = lobes.evaluate(values.vectorToEye, toLight, values.normal);
+    return Colour(f * light.intensity() * (cosTheta * pathLightScale));
+}
@@ -0,0 +1,139 @@
+//
+//  path_sampling.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef path_sampling_hpp
+#define path_sampling_hpp
+
+#include "colour.hpp"
+#include "intersection.hpp"
+#include "lighting.hpp"
+#include "material.hpp"
+#include "ray.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <optional>
+
+namespace rtlib {
+
+//The pieces of a path tracer's bounce shared by PathIntegrator and WavefrontIntegrator.
+//Anything random takes a callable returning the path's next number in [0, 1), so both
+//draw the same numbers in the same order for the same path.
+
+//point lights follow the lightPoint convention of no falloff, scaled so a lambertian
+//surface facing the light gets the same diffuse term as the Whitted integrator
+inline constexpr double pathLightScale = std::numbers::pi;
+
+double maxComponent(const Colour& colour);
+
+//turns a direction around the z axis into one around axis (Duff et al. 2017)
+Tuple aroundAxis(const Tuple& axis, double x, double y, double z);
+
+struct SurfaceLobes {
+    Colour diffuse; //albedo of the lambertian lobe
+    double specular;
+    double shininess;
+    double diffuseProbability;
+    
+    SurfaceLobes(const Material& material, const Colour& surfaceColour);
+    
+    bool empty() const;
+    
+    //normalised phong, the specular lobe is centred on the mirror direction of the eye
+    Colour evaluate(const Tuple& toEye, const Tuple& toLight, const Tuple& normal) const;
+    
+    //the mixture pdf is the balance heuristic over both sampling strategies
+    double pdf(const Tuple& toEye, const Tuple& direction, const Tuple& normal) const;
+};
+
+//one point per path on area lights, the paths average out the penumbra
+template <typename Uniform>
+Tuple lightTarget(const Light& light, const Tuple& from, Uniform& uniform) {
+    if (light.sampleCount() > 1) {
+        auto index = static_cast<unsigned int>(uniform() * light.sampleCount());
+        return light.samplePoint(index, from);
+    }
+    
+    return light.origin();
+}
+
+//light arriving from target if nothing blocks it, empty when the surface faces away
+std::optional<Colour> unshadowedPathLight(const Light& light, const Tuple& target, const IntersectValues& values, const SurfaceLobes& lobes);
+
+//picks what the path does next, surfaces keep their full weight as in shadeHits. Updates
+//the ray and throughput, or returns false when the path ends here.
+template <typename Uniform>
+bool continuePath(unsigned int depth, const IntersectValues& values, const Material& material, const SurfaceLobes& lobes, Uniform& uniform, Colour& throughput, Ray& ray) {
+    auto reflectWeight = material._reflective;
+    auto refractWeight = material._transparency;
+    if (reflectWeight > 0.0 && refractWeight > 0.0) {
+        auto reflectance = schlickReflectance(values);
+        reflectWeight *= reflectance;
+        refractWeight *= 1.0 - reflectance;
+    }
+    
+    auto surfaceWeight = lobes.empty() ? 0.0 : 1.0;
+    auto totalWeight = surfaceWeight + reflectWeight + refractWeight;
+    if (totalWeight <= 0.0) {
+        return false;
+    }
+    
+    auto choice = uniform() * totalWeight;
+    if (choice < reflectWeight) {
+        ray = Ray(values.overPoint, values.reflectionVector(), values.intersect.time);
+        throughput = throughput * totalWeight;
+    } else if (choice < reflectWeight + refractWeight) {
+        auto refractRay = refractedRay(values);
+        if (!refractRay) {
+            return false;
+        }
+        
+        ray = *refractRay;
+        throughput = throughput * totalWeight;
+    } else {
+        Tuple direction;
+        if (uniform() < lobes.diffuseProbability) {
+            //cosine weighted hemisphere
+            auto u = uniform();
+            auto phi = 2.0 * std::numbers::pi * uniform();
+            auto r = std::sqrt(u);
+            direction = aroundAxis(values.normal, r * std::cos(phi), r * std::sin(phi), std::sqrt(1.0 - u));
+        } else {
+            auto cosAlpha = std::pow(uniform(), 1.0 / (lobes.shininess + 1.0));
+            auto sinAlpha = std::sqrt(std::max(0.0, 1.0 - cosAlpha * cosAlpha));
+            auto phi = 2.0 * std::numbers::pi * uniform();
+            direction = aroundAxis(values.reflectionVector().normalised(), sinAlpha * std::cos(phi), sinAlpha * std::sin(phi), cosAlpha);
+        }
+        
+        auto cosTheta = Tuple::dot(direction, values.normal);
+        auto pdf = lobes.pdf(values.vectorToEye, direction, values.normal);
+        if (cosTheta <= 0.0 || pdf <= 0.0) {
+            return false;
+        }
+        
+        auto f = lobes.evaluate(values.vectorToEye, direction, values.normal);
+        throughput = throughput * f * (cosTheta * totalWeight / pdf);
+        ray = Ray(values.overPoint, direction, values.intersect.time);
+    }
+    
+    //russian roulette once the path has had a few bounces to pick up light
+    if (depth >= 3) {
+        auto survival = std::min(maxComponent(throughput), 0.95);
+        if (uniform() >= survival) {
+            return false;
+        }
+        
+        throughput = throughput * (1.0 / survival);
+    }
+    
+    return true;
+}
+
+}
+
+#endif /* path_sampling_hpp */
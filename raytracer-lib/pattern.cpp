@@ -14,7 +14,8 @@
 using namespace rtlib;
 
 Pattern::Pattern() :
-_transform(Matrix4x4::identityMatrix())
+_transform(Matrix4x4::identityMatrix()),
+_transformVersion(0)
 {
 }
 
@@ -24,10 +25,23 @@ Pattern::~Pattern()
 
 void Pattern::setTransform(Matrix4x4 transform) {
     _transform = transform;
+    _transformVersion++;
+}
+
+Matrix4x4 Pattern::transform() const {
+    return _transform;
+}
+
+unsigned int Pattern::transformVersion() const {
+    return _transformVersion;
 }
 
 Colour Pattern::colourAt(const Object* object, Tuple point) const {
-    auto transformedPoint = object->transform().inverse() * point;
+    return colourAt(object, point, 0.0);
+}
+
+Colour Pattern::colourAt(const Object* object, Tuple point, double time) const {
+    auto transformedPoint = object->worldToObject(point, time);
     transformedPoint = _transform.inverse() * transformedPoint;
     return colourAtLocalPoint(transformedPoint);
 }
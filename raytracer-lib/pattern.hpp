@@ -14,24 +14,31 @@
 
 namespace rtlib {
 
+class CompiledScene;
 class Object;
 
 class Pattern {
 private:
     Matrix4x4 _transform;
+    unsigned int _transformVersion;
 
 public:
     Pattern();
     ~Pattern();
     
     void setTransform(Matrix4x4 transform);
+    Matrix4x4 transform() const;
+    unsigned int transformVersion() const;
     Colour colourAt(const Object* object, Tuple point) const;
+    Colour colourAt(const Object* object, Tuple point, double time) const; //on a moving object, where it was at time
     
 protected:
     virtual Colour colourAtLocalPoint(Tuple point) const = 0;
 };
 
-class StripePattern : public Pattern {
+class StripePattern final : public Pattern {
+    friend class CompiledScene;
+    
 private:
     Colour _colourA;
     Colour _colourB;
@@ -43,7 +50,9 @@ protected:
     virtual Colour colourAtLocalPoint(Tuple point) const;
 };
 
-class GradientPattern : public Pattern {
+class GradientPattern final : public Pattern {
+    friend class CompiledScene;
+    
 private:
     Colour _colourA;
     Colour _colourB;
@@ -55,7 +64,9 @@ protected:
     virtual Colour colourAtLocalPoint(Tuple point) const;
 };
 
-class RingPattern : public Pattern {
+class RingPattern final : public Pattern {
+    friend class CompiledScene;
+    
 private:
     Colour _colourA;
     Colour _colourB;
@@ -67,7 +78,9 @@ protected:
     virtual Colour colourAtLocalPoint(Tuple point) const;
 };
 
-class CheckersPattern : public Pattern {
+class CheckersPattern final : public Pattern {
+    friend class CompiledScene;
+    
 private:
     Colour _colourA;
     Colour _colourB;
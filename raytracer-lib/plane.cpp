@@ -7,17 +7,24 @@
 
 #include "plane.hpp"
 
+#include <limits>
+
 rtlib::Intersections rtlib::Plane::intersectsImpl(const Ray& ray) const {
-    if (std::abs(ray.direction().y()) < 0.00001) {
+    double t;
+    if (!localIntersects(ray, t)) {
         return Intersections();
     }
     
     auto intersections = Intersections();
-    auto t = -ray.origin().y() / ray.direction().y();
     intersections.push_back(Intersect(this, t));
     return intersections;
 }
 
 rtlib::Tuple rtlib::Plane::normalAtImpl(const Tuple &point) const {
-    return create_vector(0.0, 1.0, 0.0);
+    return localNormal(point);
+}
+
+rtlib::BoundingBox rtlib::Plane::localBounds() const {
+    const auto infinity = std::numeric_limits<double>::infinity();
+    return BoundingBox(create_point(-infinity, 0.0, -infinity), create_point(infinity, 0.0, infinity));
 }
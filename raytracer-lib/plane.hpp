@@ -9,6 +9,9 @@
 #define plane_hpp
 
 #include "object.hpp"
+#include "ray.hpp"
+
+#include <cmath>
 
 namespace rtlib {
 
@@ -17,10 +20,29 @@ public:
     Plane() : Object() {}
     virtual ~Plane() {}
     
+    virtual BoundingBox localBounds() const;
+    
+    //object space maths shared with CompiledScene's non-virtual loops
+    static bool localIntersects(const Ray& ray, double& t);
+    static Tuple localNormal(const Tuple& point);
+    
 protected:
     virtual Intersections intersectsImpl(const Ray& ray) const;
     virtual Tuple normalAtImpl(const Tuple& point) const;
 };
 
+inline bool Plane::localIntersects(const Ray& ray, double& t) {
+    if (std::abs(ray.direction().y()) < 0.00001) {
+        return false;
+    }
+    
+    t = -ray.origin().y() / ray.direction().y();
+    return true;
+}
+
+inline Tuple Plane::localNormal(const Tuple& point) {
+    return create_vector(0.0, 1.0, 0.0);
+}
+
 }
 #endif /* plane_hpp */
@@ -11,13 +11,19 @@
 
 using namespace rtlib;
 
-Ray::Ray()
+Ray::Ray() :
+    _time(0.0)
 {
 }
 
 Ray::Ray(Tuple origin, Tuple direction) :
+    Ray(origin, direction, 0.0) {
+}
+
+Ray::Ray(Tuple origin, Tuple direction, double time) :
     _origin(origin),
-    _direction(direction) {
+    _direction(direction),
+    _time(time) {
 }
 
 bool Ray::valid() const {
@@ -32,6 +38,14 @@ Tuple Ray::direction() const {
     return _direction;
 }
 
+double Ray::time() const {
+    return _time;
+}
+
+void Ray::setTime(double time) {
+    _time = time;
+}
+
 Ray Ray::transform(const Matrix4x4& matrix) const {
     auto transformedRay = *this;
     transformedRay._origin = matrix * transformedRay._origin;
@@ -17,14 +17,18 @@ class Ray {
 private:
     Tuple _origin;
     Tuple _direction;
+    double _time; //within the shutter, for objects that move during it
     
 public:
     Ray();
     Ray(Tuple origin, Tuple direction);
+    Ray(Tuple origin, Tuple direction, double time);
     
     bool valid() const;
     Tuple origin() const;
     Tuple direction() const;
+    double time() const;
+    void setTime(double time);
     
     Ray transform(const Matrix4x4& matrix) const;
     Tuple positionAt(double t) const;
@@ -0,0 +1,96 @@
+//
+//  region.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "region.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace rtlib;
+
+unsigned int PixelRect::area() const {
+    return width * height;
+}
+
+PixelRect PixelRect::clipped(Canvas::PixelIndex canvasWidth, Canvas::PixelIndex canvasHeight) const {
+    PixelRect rect;
+    rect.x = std::min(x, canvasWidth);
+    rect.y = std::min(y, canvasHeight);
+    rect.width = std::min(width, canvasWidth - rect.x);
+    rect.height = std::min(height, canvasHeight - rect.y);
+    return rect;
+}
+
+std::vector<PixelSpan> rtlib::coveredSpans(const std::vector<PixelRect>& rects, Canvas::PixelIndex canvasWidth, Canvas::PixelIndex canvasHeight) {
+    std::vector<PixelRect> clipped;
+    Canvas::PixelIndex yStart = canvasHeight;
+    Canvas::PixelIndex yEnd = 0;
+    for (const auto& rect : rects) {
+        auto inside = rect.clipped(canvasWidth, canvasHeight);
+        if (inside.area() > 0) {
+            clipped.push_back(inside);
+            yStart = std::min(yStart, inside.y);
+            yEnd = std::max(yEnd, inside.y + inside.height);
+        }
+    }
+    
+    //per row, the rectangles crossing it sorted by start and merged where they touch
+    std::vector<PixelSpan> spans;
+    std::vector<PixelSpan> row;
+    for (auto y = yStart; y < yEnd; y++) {
+        row.clear();
+        for (const auto& rect : clipped) {
+            if (y >= rect.y && y < rect.y + rect.height) {
+                row.push_back({y, rect.x, rect.x + rect.width});
+            }
+        }
+        
+        std::sort(row.begin(), row.end(), [](const PixelSpan& a, const PixelSpan& b) {
+            return a.xStart < b.xStart;
+        });
+        
+        for (const auto& span : row) {
+            if (!spans.empty() && spans.back().y == y && span.xStart <= spans.back().xEnd) {
+                spans.back().xEnd = std::max(spans.back().xEnd, span.xEnd);
+            } else {
+                spans.push_back(span);
+            }
+        }
+    }
+    
+    return spans;
+}
+
+RegionRenderer::RegionRenderer(const Camera& camera) :
+    _camera(camera)
+{
+}
+
+unsigned int RegionRenderer::render(Canvas& canvas, const PixelRect& rect, const Trace& trace) const {
+    return render(canvas, std::vector<PixelRect>{rect}, trace);
+}
+
+unsigned int RegionRenderer::render(Canvas& canvas, const std::vector<PixelRect>& rects, const Trace& trace) const {
+    return render(canvas, coveredSpans(rects, canvas.width(), canvas.height()), trace);
+}
+
+unsigned int RegionRenderer::render(Canvas& canvas, const std::vector<PixelSpan>& spans, const Trace& trace) const {
+    if (canvas.width() != _camera.horizontalSize() || canvas.height() != _camera.verticalSize()) {
+        throw std::invalid_argument("a region must be rendered into a canvas the camera's size");
+    }
+    
+    unsigned int rendered = 0;
+    for (const auto& span : spans) {
+        for (auto x = span.xStart; x < span.xEnd; x++) {
+            canvas.writePixel(x, span.y, trace(_camera.rayForPixel(x, span.y)));
+        }
+        
+        rendered += span.xEnd - span.xStart;
+    }
+    
+    return rendered;
+}
@@ -0,0 +1,62 @@
+//
+//  region.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef region_hpp
+#define region_hpp
+
+#include "camera.hpp"
+#include "canvas.hpp"
+#include "colour.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace rtlib {
+
+//pixels [x, x + width) x [y, y + height)
+struct PixelRect {
+    Canvas::PixelIndex x;
+    Canvas::PixelIndex y;
+    Canvas::PixelIndex width;
+    Canvas::PixelIndex height;
+    
+    unsigned int area() const;
+    PixelRect clipped(Canvas::PixelIndex canvasWidth, Canvas::PixelIndex canvasHeight) const;
+};
+
+//part of a row, pixels [xStart, xEnd)
+struct PixelSpan {
+    Canvas::PixelIndex y;
+    Canvas::PixelIndex xStart;
+    Canvas::PixelIndex xEnd;
+};
+
+//every pixel covered by the rectangles exactly once, clipped to the canvas and in scanline order
+std::vector<PixelSpan> coveredSpans(const std::vector<PixelRect>& rects, Canvas::PixelIndex canvasWidth, Canvas::PixelIndex canvasHeight);
+
+//Crop window rendering into an existing canvas. Only the covered pixels are traced and
+//written, each with the same camera ray a full frame render gives it, so a patched
+//region matches the frame around it and costs only its own area.
+class RegionRenderer {
+public:
+    typedef std::function<Colour(const Ray&)> Trace;
+    
+private:
+    const Camera& _camera;
+    
+public:
+    RegionRenderer(const Camera& camera);
+    
+    //each returns the number of pixels rendered, overlapping rectangles are rendered once
+    unsigned int render(Canvas& canvas, const PixelRect& rect, const Trace& trace) const;
+    unsigned int render(Canvas& canvas, const std::vector<PixelRect>& rects, const Trace& trace) const;
+    unsigned int render(Canvas& canvas, const std::vector<PixelSpan>& spans, const Trace& trace) const;
+};
+
+}
+
+#endif /* region_hpp */
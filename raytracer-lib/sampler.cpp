@@ -0,0 +1,256 @@
+//
+//  sampler.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "sampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace rtlib;
+
+namespace {
+
+const double largestBelowOne = 1.0 - std::numeric_limits<double>::epsilon() / 2.0;
+
+//lowbias32 (Wellons)
+uint32_t hash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+}
+
+uint32_t hash(uint32_t a, uint32_t b) {
+    return hash(a ^ hash(b + 0x9e3779b9));
+}
+
+uint32_t hash(uint32_t a, uint32_t b, uint32_t c) {
+    return hash(a, hash(b, c));
+}
+
+double toUnit(uint32_t value) {
+    return std::min(value * 0x1p-32, largestBelowOne);
+}
+
+uint32_t reverseBits(uint32_t x) {
+    x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+    x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+    x = ((x >> 4) & 0x0f0f0f0f) | ((x & 0x0f0f0f0f) << 4);
+    x = ((x >> 8) & 0x00ff00ff) | ((x & 0x00ff00ff) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+//Owen scrambling as a hash over the reversed bits, each bit only depends on those above it
+uint32_t nestedUniformScramble(uint32_t x, uint32_t seed) {
+    x = reverseBits(x);
+    x += seed;
+    x ^= x * 0x6c50b47c;
+    x ^= x * 0xb82f1e52;
+    x ^= x * 0xc7afe638;
+    x ^= x * 0x8d22f6e6;
+    return reverseBits(x);
+}
+
+//direction numbers from the primitive polynomials of Joe and Kuo, dimension 0 is van der Corput
+struct SobolTable {
+    uint32_t directions[SobolSampler::tableDimensions][32];
+    
+    constexpr SobolTable() : directions() {
+        const unsigned int degree[] = {0, 1, 2, 3};
+        const unsigned int coefficients[] = {0, 0, 1, 1};
+        const unsigned int initial[][3] = {{0, 0, 0}, {1, 0, 0}, {1, 3, 0}, {1, 3, 1}};
+        
+        for (unsigned int bit = 0; bit < 32; bit++) {
+            directions[0][bit] = 1u << (31 - bit);
+        }
+        
+        for (unsigned int d = 1; d < SobolSampler::tableDimensions; d++) {
+            auto s = degree[d];
+            for (unsigned int i = 0; i < 32; i++) {
+                if (i < s) {
+                    directions[d][i] = initial[d][i] << (31 - i);
+                } else {
+                    auto v = directions[d][i - s] ^ (directions[d][i - s] >> s);
+                    for (unsigned int k = 1; k < s; k++) {
+                        v ^= ((coefficients[d] >> (s - 1 - k)) & 1) * directions[d][i - k];
+                    }
+                    directions[d][i] = v;
+                }
+            }
+        }
+    }
+};
+
+constexpr SobolTable sobolTable;
+
+uint32_t sobol(uint32_t index, unsigned int dimension) {
+    uint32_t result = 0;
+    for (unsigned int bit = 0; index != 0; bit++, index >>= 1) {
+        if (index & 1) {
+            result ^= sobolTable.directions[dimension][bit];
+        }
+    }
+    
+    return result;
+}
+
+//Kensler's hashed permutation of [0, length), cycle walking past length
+uint32_t permute(uint32_t i, uint32_t length, uint32_t seed) {
+    uint32_t mask = length - 1;
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    
+    do {
+        i ^= seed;
+        i *= 0xe170893d;
+        i ^= seed >> 16;
+        i ^= (i & mask) >> 4;
+        i ^= seed >> 8;
+        i *= 0x0929eb3f;
+        i ^= seed >> 23;
+        i ^= (i & mask) >> 1;
+        i *= 1 | seed >> 27;
+        i *= 0x6935fa69;
+        i ^= (i & mask) >> 11;
+        i *= 0x74dcb303;
+        i ^= (i & mask) >> 2;
+        i *= 0x9e501cc3;
+        i ^= (i & mask) >> 2;
+        i *= 0xc860a3df;
+        i &= mask;
+        i ^= i >> 5;
+    } while (i >= length);
+    
+    return (i + seed) % length;
+}
+
+}
+
+Sampler::Sampler(uint32_t seed) :
+    _seed(seed)
+{
+}
+
+uint32_t Sampler::seed() const {
+    return _seed;
+}
+
+std::array<double, 2> Sampler::sample2D(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const {
+    return {sample(x, y, index, dimension), sample(x, y, index, dimension + 1)};
+}
+
+uint32_t Sampler::pixelSeed(unsigned int x, unsigned int y) const {
+    return hash(x, y, _seed);
+}
+
+SobolSampler::SobolSampler(uint32_t seed) :
+    Sampler(seed)
+{
+}
+
+double SobolSampler::sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const {
+    auto seed = pixelSeed(x, y);
+    auto group = dimension / tableDimensions;
+    
+    auto shuffled = nestedUniformScramble(index, hash(seed, group));
+    auto value = sobol(shuffled, dimension % tableDimensions);
+    return toUnit(nestedUniformScramble(value, hash(seed, dimension + 0x51ed270b)));
+}
+
+BlueNoiseSampler::BlueNoiseSampler(unsigned int tileSize, uint32_t seed) :
+    Sampler(seed),
+    _tileSize(tileSize),
+    _ranks(tileSize * tileSize)
+{
+    if (tileSize == 0) {
+        throw std::invalid_argument("blue noise tile can't be empty");
+    }
+    
+    //void and cluster without the initial pattern: each rank goes to the emptiest pixel,
+    //measured with a gaussian energy that wraps around the tile so it tiles seamlessly
+    const double sigma = 1.5;
+    const auto pixels = tileSize * tileSize;
+    std::vector<double> kernel(pixels);
+    for (unsigned int dy = 0; dy < tileSize; dy++) {
+        for (unsigned int dx = 0; dx < tileSize; dx++) {
+            auto wrappedX = static_cast<double>(std::min(dx, tileSize - dx));
+            auto wrappedY = static_cast<double>(std::min(dy, tileSize - dy));
+            kernel[dy * tileSize + dx] = std::exp(-(wrappedX * wrappedX + wrappedY * wrappedY) / (2.0 * sigma * sigma));
+        }
+    }
+    
+    std::vector<double> energy(pixels, 0.0);
+    std::vector<bool> taken(pixels, false);
+    auto next = hash(seed) % pixels;
+    
+    for (uint32_t rank = 0; rank < pixels; rank++) {
+        _ranks[next] = rank;
+        taken[next] = true;
+        
+        auto px = next % tileSize;
+        auto py = next / tileSize;
+        auto emptiest = pixels;
+        for (unsigned int y = 0; y < tileSize; y++) {
+            auto dy = (y + tileSize - py) % tileSize;
+            for (unsigned int x = 0; x < tileSize; x++) {
+                auto dx = (x + tileSize - px) % tileSize;
+                auto pixel = y * tileSize + x;
+                energy[pixel] += kernel[dy * tileSize + dx];
+                if (!taken[pixel] && (emptiest == pixels || energy[pixel] < energy[emptiest])) {
+                    emptiest = pixel;
+                }
+            }
+        }
+        
+        next = emptiest;
+    }
+}
+
+unsigned int BlueNoiseSampler::tileSize() const {
+    return _tileSize;
+}
+
+uint32_t BlueNoiseSampler::rankAt(unsigned int x, unsigned int y) const {
+    return _ranks[(y % _tileSize) * _tileSize + x % _tileSize];
+}
+
+double BlueNoiseSampler::sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const {
+    auto offset = hash(dimension, seed());
+    auto rank = rankAt(x + (offset & 0xffff), y + (offset >> 16));
+    
+    const double goldenRatio = 0.6180339887498949;
+    auto value = (rank + 0.5) / _ranks.size() + goldenRatio * index;
+    return std::min(value - std::floor(value), largestBelowOne);
+}
+
+StratifiedSampler::StratifiedSampler(unsigned int samplesPerPixel, uint32_t seed) :
+    Sampler(seed),
+    _samplesPerPixel(samplesPerPixel)
+{
+    if (samplesPerPixel == 0) {
+        throw std::invalid_argument("stratified sampler needs at least one sample per pixel");
+    }
+}
+
+unsigned int StratifiedSampler::samplesPerPixel() const {
+    return _samplesPerPixel;
+}
+
+double StratifiedSampler::sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const {
+    auto round = index / _samplesPerPixel;
+    auto seed = hash(pixelSeed(x, y), dimension, round);
+    auto stratum = permute(index % _samplesPerPixel, _samplesPerPixel, seed);
+    auto jitter = toUnit(hash(seed, index));
+    return std::min((stratum + jitter) / _samplesPerPixel, largestBelowOne);
+}
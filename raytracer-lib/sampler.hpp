@@ -0,0 +1,83 @@
+//
+//  sampler.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef sampler_hpp
+#define sampler_hpp
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace rtlib {
+
+//Sample values in [0, 1) addressed by pixel, sample index and dimension. Every value is
+//a pure function of those and the seed, so samplers are safe to share between threads
+//and a render gives the same image however its pixels are scheduled.
+class Sampler {
+private:
+    uint32_t _seed;
+    
+public:
+    Sampler(uint32_t seed);
+    virtual ~Sampler() {}
+    
+    uint32_t seed() const;
+    
+    virtual double sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const = 0;
+    std::array<double, 2> sample2D(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const;
+    
+protected:
+    uint32_t pixelSeed(unsigned int x, unsigned int y) const;
+};
+
+//Sobol points with hash based Owen scrambling, decorrelated per pixel. The four
+//dimensions of the table are reused for higher dimensions by shuffling the sample
+//order per group of four (Burley 2020).
+class SobolSampler final : public Sampler {
+public:
+    static const unsigned int tableDimensions = 4;
+    
+    SobolSampler(uint32_t seed = 0);
+    
+    virtual double sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const;
+};
+
+//Ranks from a void and cluster blue noise tile, built once when the sampler is made.
+//Each dimension reads the tile at its own offset and successive samples step the
+//value along the golden ratio so they stay well spread over time.
+class BlueNoiseSampler final : public Sampler {
+private:
+    unsigned int _tileSize;
+    std::vector<uint32_t> _ranks;
+    
+public:
+    BlueNoiseSampler(unsigned int tileSize = 64, uint32_t seed = 0);
+    
+    unsigned int tileSize() const;
+    uint32_t rankAt(unsigned int x, unsigned int y) const;
+    
+    virtual double sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const;
+};
+
+//Jittered strata per dimension, each pixel and dimension taking the strata in its own
+//shuffled order so dimensions don't correlate. Every run of samplesPerPixel samples
+//covers each stratum once.
+class StratifiedSampler final : public Sampler {
+private:
+    unsigned int _samplesPerPixel;
+    
+public:
+    StratifiedSampler(unsigned int samplesPerPixel, uint32_t seed = 0);
+    
+    unsigned int samplesPerPixel() const;
+    
+    virtual double sample(unsigned int x, unsigned int y, unsigned int index, unsigned int dimension) const;
+};
+
+}
+
+#endif /* sampler_hpp */
@@ -10,29 +10,21 @@
 #include "intersection.hpp"
 
 rtlib::Intersections rtlib::Sphere::intersectsImpl(const Ray& ray) const {
-    const auto centre = rtlib::create_point(0.0, 0.0, 0.0);
-    const auto radius = 1.0;
-    const auto sphere_to_ray = ray.origin() - centre;
-    
-    auto a = rtlib::Tuple::dot(ray.direction(), ray.direction());
-    auto b = 2 * rtlib::Tuple::dot(ray.direction(), sphere_to_ray);
-    auto c = rtlib::Tuple::dot(sphere_to_ray, sphere_to_ray) - radius;
-    
-    auto discriminant = (b * b) - (4 * a * c);
-    if (discriminant < 0) {
+    double t1, t2;
+    if (!localIntersects(ray, t1, t2)) {
         return Intersections();
     }
-        
-    Intersect hit1(this, (-b - std::sqrt(discriminant)) / (2 * a));
-    Intersect hit2(this, (-b + std::sqrt(discriminant)) / (2 * a));
     
     Intersections hits;
-    hits.push_back(hit1);
-    hits.push_back(hit2);
+    hits.push_back(Intersect(this, t1));
+    hits.push_back(Intersect(this, t2));
     return hits;
 }
 
 rtlib::Tuple rtlib::Sphere::normalAtImpl(const Tuple &point) const {
-    auto objectNormal = point - rtlib::create_point(0.0, 0.0, 0.0);
-    return objectNormal;
+    return localNormal(point);
+}
+
+rtlib::BoundingBox rtlib::Sphere::localBounds() const {
+    return BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0));
 }
@@ -10,6 +10,9 @@
 
 
 #include "object.hpp"
+#include "ray.hpp"
+
+#include <cmath>
 
 namespace rtlib {
 
@@ -18,11 +21,40 @@ public:
     Sphere() : Object() {}
     virtual ~Sphere() {}
     
+    virtual BoundingBox localBounds() const;
+    
+    //object space maths shared with CompiledScene's non-virtual loops
+    static bool localIntersects(const Ray& ray, double& t1, double& t2);
+    static Tuple localNormal(const Tuple& point);
+    
 protected:
     virtual Intersections intersectsImpl(const Ray& ray) const;
     virtual Tuple normalAtImpl(const Tuple& point) const;
 };
 
+inline bool Sphere::localIntersects(const Ray& ray, double& t1, double& t2) {
+    const auto centre = rtlib::create_point(0.0, 0.0, 0.0);
+    const auto radius = 1.0;
+    const auto sphere_to_ray = ray.origin() - centre;
+    
+    auto a = rtlib::Tuple::dot(ray.direction(), ray.direction());
+    auto b = 2 * rtlib::Tuple::dot(ray.direction(), sphere_to_ray);
+    auto c = rtlib::Tuple::dot(sphere_to_ray, sphere_to_ray) - radius;
+    
+    auto discriminant = (b * b) - (4 * a * c);
+    if (discriminant < 0) {
+        return false;
+    }
+    
+    t1 = (-b - std::sqrt(discriminant)) / (2 * a);
+    t2 = (-b + std::sqrt(discriminant)) / (2 * a);
+    return true;
+}
+
+inline Tuple Sphere::localNormal(const Tuple& point) {
+    return point - rtlib::create_point(0.0, 0.0, 0.0);
+}
+
 }
 
 
@@ -0,0 +1,212 @@
+//
+//  sphere_set.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "sphere_set.hpp"
+
+#include <limits>
+#include <simd/simd.h>
+#include <stdexcept>
+
+using namespace rtlib;
+
+namespace {
+
+inline simd_double4 load(const std::vector<double>& values, unsigned int first) {
+    //the arrays are only 8 byte aligned, so go through the packed type
+    return *reinterpret_cast<const simd_packed_double4*>(values.data() + first);
+}
+
+template<typename T>
+void reorder(std::vector<T>& values, const std::vector<unsigned int>& order) {
+    auto original = values;
+    for (unsigned int i = 0; i < order.size(); i++) {
+        values[i] = original[order[i]];
+    }
+}
+
+}
+
+SphereSet::SphereSet() :
+    Object(),
+    _count(0)
+{
+    resize(0);
+}
+
+unsigned int SphereSet::addMaterial(const Material& material) {
+    _materials.push_back(material);
+    return static_cast<unsigned int>(_materials.size() - 1);
+}
+
+void SphereSet::addSphere(const Tuple& centre, double radius, unsigned int material) {
+    auto index = _count;
+    resize(_count + 1);
+    
+    _centreX[index] = centre.x();
+    _centreY[index] = centre.y();
+    _centreZ[index] = centre.z();
+    _radius[index] = radius;
+    _materialIndex[index] = material;
+    _sphereIndex[index] = index;
+    
+    _bounds.addBox(BoundingBox(create_point(centre.x() - radius, centre.y() - radius, centre.z() - radius),
+                               create_point(centre.x() + radius, centre.y() + radius, centre.z() + radius)));
+    
+    //the new sphere isn't in any leaf until the next build
+    _bvh.reset();
+    geometryChanged();
+}
+
+void SphereSet::build(unsigned int maxLeafSize) {
+    std::vector<BoundingBox> bounds;
+    bounds.reserve(_count);
+    for (unsigned int i = 0; i < _count; i++) {
+        auto centre = create_point(_centreX[i], _centreY[i], _centreZ[i]);
+        auto extent = create_vector(_radius[i], _radius[i], _radius[i]);
+        bounds.push_back(BoundingBox(centre - extent, centre + extent));
+    }
+    
+    _bvh = std::make_unique<BVH>(std::move(bounds), maxLeafSize);
+    
+    //lay the spheres out in leaf order so every leaf is a contiguous range of the arrays
+    const auto& order = _bvh->primitives();
+    reorder(_centreX, order);
+    reorder(_centreY, order);
+    reorder(_centreZ, order);
+    reorder(_radius, order);
+    reorder(_materialIndex, order);
+    reorder(_sphereIndex, order);
+    
+    //leaf ranges a world BVH copied no longer match the arrays
+    geometryChanged();
+}
+
+unsigned int SphereSet::size() const {
+    return _count;
+}
+
+const BVH* SphereSet::bvh() const {
+    return _bvh.get();
+}
+
+unsigned int SphereSet::sphereIndex(const Intersect& hit) const {
+    return _sphereIndex[hit.primitive];
+}
+
+BoundingBox SphereSet::localBounds() const {
+    return _bounds;
+}
+
+Material SphereSet::materialAt(const Intersect& hit) const {
+    auto index = _materialIndex[hit.primitive];
+    return index < _materials.size() ? _materials[index] : material();
+}
+
+std::vector<Material> SphereSet::materials() const {
+    auto all = _materials;
+    all.push_back(material()); //spheres added without a material
+    return all;
+}
+
+std::vector<Object::PrimitiveRange> SphereSet::primitiveRanges() const {
+    std::vector<PrimitiveRange> ranges;
+    if (!_bvh || _bvh->root() == BVH::noNode) {
+        return ranges;
+    }
+    
+    const auto& nodes = _bvh->nodes();
+    std::vector<unsigned int> stack = {_bvh->root()};
+    while (!stack.empty()) {
+        const auto& node = nodes[stack.back()];
+        stack.pop_back();
+        
+        if (node.leaf) {
+            ranges.push_back({node.first, node.count, worldBounds(node.bounds)});
+        } else {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+    
+    return ranges;
+}
+
+Intersections SphereSet::intersectsImpl(const Ray& ray) const {
+    Intersections hits;
+    
+    if (_bvh) {
+        //spheres entirely behind the ray origin are culled along with their leaves
+        _bvh->traverseLeaves(ray, std::numeric_limits<double>::infinity(), [&](unsigned int first, unsigned int count) {
+            intersectRange(ray, first, count, hits);
+        });
+    } else {
+        intersectRange(ray, 0, _count, hits);
+    }
+    
+    return hits;
+}
+
+void SphereSet::intersectsRangeImpl(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const {
+    intersectRange(ray, first, count, hits);
+}
+
+Tuple SphereSet::normalAtImpl(const Tuple& point) const {
+    throw std::logic_error("sphere set normals need the hit to know which sphere");
+}
+
+Tuple SphereSet::normalAtImpl(const Tuple& point, const Intersect& hit) const {
+    return point - create_point(_centreX[hit.primitive], _centreY[hit.primitive], _centreZ[hit.primitive]);
+}
+
+void SphereSet::resize(unsigned int count) {
+    _count = count;
+    
+    auto padded = count + batchSize - 1;
+    _centreX.resize(padded, 0.0);
+    _centreY.resize(padded, 0.0);
+    _centreZ.resize(padded, 0.0);
+    _radius.resize(padded, 0.0);
+    _materialIndex.resize(padded, noMaterial);
+    _sphereIndex.resize(padded, 0);
+}
+
+void SphereSet::intersectRange(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const {
+    //same analytic form as Sphere::localIntersects, with the centre and radius per lane
+    const auto origin = ray.origin();
+    const auto direction = ray.direction();
+    const auto a = Tuple::dot(direction, direction);
+    const auto lane = simd_make_double4(0.0, 1.0, 2.0, 3.0);
+    const auto end = first + count;
+    
+    for (unsigned int i = first; i < end; i += batchSize) {
+        auto toRayX = origin.x() - load(_centreX, i);
+        auto toRayY = origin.y() - load(_centreY, i);
+        auto toRayZ = origin.z() - load(_centreZ, i);
+        auto radius = load(_radius, i);
+        
+        auto b = 2.0 * (direction.x() * toRayX + direction.y() * toRayY + direction.z() * toRayZ);
+        auto c = toRayX * toRayX + toRayY * toRayY + toRayZ * toRayZ - radius * radius;
+        auto discriminant = b * b - 4.0 * a * c;
+        
+        //lanes past the end of the range belong to the next leaf or the padding
+        auto hit = (discriminant >= 0.0) & (lane < static_cast<double>(end - i));
+        if (!simd_any(hit)) {
+            continue;
+        }
+        
+        auto root = simd::sqrt(discriminant);
+        auto t1 = (-b - root) / (2.0 * a);
+        auto t2 = (-b + root) / (2.0 * a);
+        
+        for (unsigned int l = 0; l < batchSize; l++) {
+            if (hit[l]) {
+                hits.push_back(Intersect(this, t1[l], i + l));
+                hits.push_back(Intersect(this, t2[l], i + l));
+            }
+        }
+    }
+}
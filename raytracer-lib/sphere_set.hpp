@@ -0,0 +1,76 @@
+//
+//  sphere_set.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef sphere_set_hpp
+#define sphere_set_hpp
+
+#include "bvh.hpp"
+#include "object.hpp"
+#include "ray.hpp"
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace rtlib {
+
+//Many spheres held as one object. Centres, radii and material indices are stored
+//as separate arrays so four spheres are intersected at once with simd_double4, and
+//spheres are described by centre and radius so no per sphere inverse is needed.
+//build() sorts the arrays into the order of an internal BVH's leaves, letting each
+//leaf be tested as a contiguous range. A world BVH takes those leaves as its own
+//primitives, so the spheres are split alongside the rest of the scene and each ray
+//walks one tree; the internal tree only serves sets intersected on their own.
+class SphereSet : public Object {
+public:
+    static constexpr unsigned int batchSize = 4;
+    static constexpr unsigned int noMaterial = std::numeric_limits<unsigned int>::max();
+    
+private:
+    //per sphere data, padded by batchSize - 1 entries so a batch can always be loaded
+    std::vector<double> _centreX;
+    std::vector<double> _centreY;
+    std::vector<double> _centreZ;
+    std::vector<double> _radius;
+    std::vector<unsigned int> _materialIndex;
+    std::vector<unsigned int> _sphereIndex; //array position to the order spheres were added in
+    std::vector<Material> _materials;
+    std::unique_ptr<BVH> _bvh;
+    BoundingBox _bounds;
+    unsigned int _count;
+    
+public:
+    SphereSet();
+    virtual ~SphereSet() {}
+    
+    unsigned int addMaterial(const Material& material);
+    void addSphere(const Tuple& centre, double radius, unsigned int material = noMaterial);
+    void build(unsigned int maxLeafSize = 8);
+    
+    unsigned int size() const;
+    const BVH* bvh() const;
+    unsigned int sphereIndex(const Intersect& hit) const;
+    
+    virtual BoundingBox localBounds() const;
+    virtual Material materialAt(const Intersect& hit) const;
+    virtual std::vector<Material> materials() const;
+    virtual std::vector<PrimitiveRange> primitiveRanges() const; //the internal BVH's leaves, none before build()
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const;
+    virtual void intersectsRangeImpl(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const;
+    virtual Tuple normalAtImpl(const Tuple& point) const;
+    virtual Tuple normalAtImpl(const Tuple& point, const Intersect& hit) const;
+    
+private:
+    void resize(unsigned int count);
+    void intersectRange(const Ray& ray, unsigned int first, unsigned int count, Intersections& hits) const;
+};
+
+}
+
+#endif /* sphere_set_hpp */
@@ -9,6 +9,7 @@
 
 #include "matrix.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace rtlib;
@@ -107,3 +108,138 @@ Matrix4x4 rtlib::viewTransform(const Tuple &from, const Tuple &to, const Tuple &
     
     return orientation;
 }
+
+namespace {
+
+Matrix4x4 rotationFromQuaternion(const std::array<double, 4>& q) {
+    auto [x, y, z, w] = q;
+    auto matrix = Matrix4x4::identityMatrix();
+    matrix.set(0, 0, 1.0 - 2.0 * (y * y + z * z));
+    matrix.set(0, 1, 2.0 * (x * y - z * w));
+    matrix.set(0, 2, 2.0 * (x * z + y * w));
+    matrix.set(1, 0, 2.0 * (x * y + z * w));
+    matrix.set(1, 1, 1.0 - 2.0 * (x * x + z * z));
+    matrix.set(1, 2, 2.0 * (y * z - x * w));
+    matrix.set(2, 0, 2.0 * (x * z - y * w));
+    matrix.set(2, 1, 2.0 * (y * z + x * w));
+    matrix.set(2, 2, 1.0 - 2.0 * (x * x + y * y));
+    
+    return matrix;
+}
+
+std::array<double, 4> quaternionFromRotation(const Matrix4x4& m) {
+    auto trace = m.at(0, 0) + m.at(1, 1) + m.at(2, 2);
+    std::array<double, 4> q;
+    
+    //built from the largest of w, x, y and z to keep the division stable
+    if (trace > 0.0) {
+        auto s = std::sqrt(trace + 1.0) * 2.0;
+        q = {(m.at(2, 1) - m.at(1, 2)) / s, (m.at(0, 2) - m.at(2, 0)) / s, (m.at(1, 0) - m.at(0, 1)) / s, 0.25 * s};
+    } else if (m.at(0, 0) > m.at(1, 1) && m.at(0, 0) > m.at(2, 2)) {
+        auto s = std::sqrt(1.0 + m.at(0, 0) - m.at(1, 1) - m.at(2, 2)) * 2.0;
+        q = {0.25 * s, (m.at(0, 1) + m.at(1, 0)) / s, (m.at(0, 2) + m.at(2, 0)) / s, (m.at(2, 1) - m.at(1, 2)) / s};
+    } else if (m.at(1, 1) > m.at(2, 2)) {
+        auto s = std::sqrt(1.0 + m.at(1, 1) - m.at(0, 0) - m.at(2, 2)) * 2.0;
+        q = {(m.at(0, 1) + m.at(1, 0)) / s, 0.25 * s, (m.at(1, 2) + m.at(2, 1)) / s, (m.at(0, 2) - m.at(2, 0)) / s};
+    } else {
+        auto s = std::sqrt(1.0 + m.at(2, 2) - m.at(0, 0) - m.at(1, 1)) * 2.0;
+        q = {(m.at(0, 2) + m.at(2, 0)) / s, (m.at(1, 2) + m.at(2, 1)) / s, 0.25 * s, (m.at(1, 0) - m.at(0, 1)) / s};
+    }
+    
+    return q;
+}
+
+double quaternionDot(const std::array<double, 4>& a, const std::array<double, 4>& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+}
+
+}
+
+DecomposedTransform rtlib::decompose(const Matrix4x4& transform) {
+    DecomposedTransform parts;
+    parts.translation = create_vector(transform.at(0, 3), transform.at(1, 3), transform.at(2, 3));
+    
+    auto linear = transform;
+    linear.set(0, 3, 0.0);
+    linear.set(1, 3, 0.0);
+    linear.set(2, 3, 0.0);
+    
+    //averaging with the inverse transpose converges on the nearest orthogonal matrix
+    auto rotation = linear;
+    for (unsigned int iteration = 0; iteration < 100; iteration++) {
+        auto inverseTranspose = rotation.inverse().transpose();
+        double change = 0.0;
+        for (unsigned int row = 0; row < 3; row++) {
+            for (unsigned int column = 0; column < 3; column++) {
+                auto next = 0.5 * (rotation.at(row, column) + inverseTranspose.at(row, column));
+                change = std::max(change, std::abs(next - rotation.at(row, column)));
+                rotation.set(row, column, next);
+            }
+        }
+        
+        if (change < 1e-12) {
+            break;
+        }
+    }
+    
+    //a mirroring transform leaves a reflection, which is moved into the scale
+    if (rotation.determinant() < 0.0) {
+        for (unsigned int row = 0; row < 3; row++) {
+            for (unsigned int column = 0; column < 3; column++) {
+                rotation.set(row, column, -rotation.at(row, column));
+            }
+        }
+    }
+    
+    parts.rotation = quaternionFromRotation(rotation);
+    parts.scale = rotation.inverse() * linear;
+    return parts;
+}
+
+Matrix4x4 rtlib::interpolate(const DecomposedTransform& start, const DecomposedTransform& end, double t) {
+    auto translationPart = start.translation + (end.translation - start.translation) * t;
+    
+    //slerp along the shorter arc, falling back to a normalised lerp when the two are nearly equal
+    auto from = start.rotation;
+    auto to = end.rotation;
+    auto cosine = quaternionDot(from, to);
+    if (cosine < 0.0) {
+        cosine = -cosine;
+        for (auto& value : to) {
+            value = -value;
+        }
+    }
+    
+    std::array<double, 4> rotation;
+    if (cosine > 0.9995) {
+        for (unsigned int i = 0; i < 4; i++) {
+            rotation[i] = from[i] + (to[i] - from[i]) * t;
+        }
+        
+        auto length = std::sqrt(quaternionDot(rotation, rotation));
+        for (auto& value : rotation) {
+            value /= length;
+        }
+    } else {
+        auto angle = std::acos(cosine);
+        auto fromWeight = std::sin((1.0 - t) * angle) / std::sin(angle);
+        auto toWeight = std::sin(t * angle) / std::sin(angle);
+        for (unsigned int i = 0; i < 4; i++) {
+            rotation[i] = from[i] * fromWeight + to[i] * toWeight;
+        }
+    }
+    
+    auto scale = Matrix4x4::identityMatrix();
+    for (unsigned int row = 0; row < 3; row++) {
+        for (unsigned int column = 0; column < 3; column++) {
+            scale.set(row, column, start.scale.at(row, column) + (end.scale.at(row, column) - start.scale.at(row, column)) * t);
+        }
+    }
+    
+    return translation(translationPart.x(), translationPart.y(), translationPart.z()) * rotationFromQuaternion(rotation) * scale;
+}
+
+double rtlib::rotationAngle(const DecomposedTransform& start, const DecomposedTransform& end) {
+    auto cosine = std::min(1.0, std::abs(quaternionDot(start.rotation, end.rotation)));
+    return 2.0 * std::acos(cosine);
+}
@@ -10,6 +10,8 @@
 
 #include "matrix.hpp"
 
+#include <array>
+
 namespace rtlib {
 
 Matrix4x4 translation(double x, double y, double z);
@@ -21,6 +23,19 @@ Matrix4x4 shearing(double xy, double xz, double yx, double yz, double zx, double
 
 Matrix4x4 viewTransform(const Tuple& from, const Tuple& to, const Tuple& up);
 
+//An affine transform split into translation * rotation * scale, with the rotation
+//taken out by polar decomposition. Blending the parts instead of the matrices keeps
+//a rotating object rigid rather than shrinking it through the middle of the turn.
+struct DecomposedTransform {
+    Tuple translation;
+    std::array<double, 4> rotation; //unit quaternion as x, y, z, w
+    Matrix4x4 scale; //symmetric, keeps any shear too
+};
+
+DecomposedTransform decompose(const Matrix4x4& transform);
+Matrix4x4 interpolate(const DecomposedTransform& start, const DecomposedTransform& end, double t); //slerps the rotation, lerps the rest
+double rotationAngle(const DecomposedTransform& start, const DecomposedTransform& end); //radians turned between the two
+
 }
 
 #endif /* transformations_hpp */
@@ -0,0 +1,305 @@
+//
+//  wavefront_integrator.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "wavefront_integrator.hpp"
+
+#include "lighting.hpp"
+#include "object.hpp"
+#include "path_sampling.hpp"
+#include "world.hpp"
+
+#include <algorithm>
+
+using namespace rtlib;
+
+namespace {
+
+//splitmix64 finaliser, spreads the path's pixel and sample index over the generator's seed
+uint32_t pathSeed(unsigned int seed, unsigned int pixel, unsigned int sampleIndex) {
+    uint64_t z = (static_cast<uint64_t>(seed) << 32) ^ (static_cast<uint64_t>(pixel) * 0x9e3779b97f4a7c15ull) ^ sampleIndex;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+
+}
+
+void WavefrontIntegrator::RayQueue::resize(unsigned int capacity) {
+    for (auto* values : {&originX, &originY, &originZ, &directionX, &directionY, &directionZ, &times}) {
+        values->resize(capacity);
+    }
+    
+    paths.resize(capacity);
+    size = 0;
+}
+
+void WavefrontIntegrator::RayQueue::push(const Ray& ray, unsigned int path) {
+    auto slot = size.fetch_add(1, std::memory_order_relaxed);
+    auto origin = ray.origin();
+    auto direction = ray.direction();
+    originX[slot] = origin.x();
+    originY[slot] = origin.y();
+    originZ[slot] = origin.z();
+    directionX[slot] = direction.x();
+    directionY[slot] = direction.y();
+    directionZ[slot] = direction.z();
+    times[slot] = ray.time();
+    paths[slot] = path;
+}
+
+Ray WavefrontIntegrator::RayQueue::ray(unsigned int index) const {
+    return Ray(create_point(originX[index], originY[index], originZ[index]), create_vector(directionX[index], directionY[index], directionZ[index]), times[index]);
+}
+
+void WavefrontIntegrator::ShadowQueue::resize(unsigned int capacity) {
+    for (auto* values : {&originX, &originY, &originZ, &targetX, &targetY, &targetZ, &times, &red, &green, &blue}) {
+        values->resize(capacity);
+    }
+    
+    lights.resize(capacity);
+    visible.resize(capacity);
+    size = 0;
+}
+
+unsigned int WavefrontIntegrator::ShadowQueue::claim(unsigned int count) {
+    //a path's shadow rays are kept together so accumulate can add them in light order
+    return size.fetch_add(count, std::memory_order_relaxed);
+}
+
+WavefrontIntegrator::WavefrontIntegrator(const World& world, unsigned int maxDepth, unsigned int seed) :
+    _world(world),
+    _maxDepth(maxDepth),
+    _seed(seed),
+    _parallelFor([](unsigned int size, const Kernel& kernel) { kernel(0, size); })
+{
+}
+
+unsigned int WavefrontIntegrator::maxDepth() const {
+    return _maxDepth;
+}
+
+const Sampler* WavefrontIntegrator::sampler() const {
+    return _sampler.get();
+}
+
+void WavefrontIntegrator::setSampler(std::shared_ptr<const Sampler> sampler) {
+    _sampler = std::move(sampler);
+}
+
+void WavefrontIntegrator::setParallelFor(ParallelFor parallelFor) {
+    _parallelFor = std::move(parallelFor);
+}
+
+const WavefrontIntegrator::StageTimings& WavefrontIntegrator::timings() const {
+    return _timings;
+}
+
+void WavefrontIntegrator::resetTimings() {
+    _timings = StageTimings();
+}
+
+void WavefrontIntegrator::accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel) {
+    const auto pathCount = buffer.width() * buffer.height();
+    const auto lightsPerHit = _world.lightBvh() ? 1u : static_cast<unsigned int>(_world.lights().size());
+    
+    _paths.resize(pathCount);
+    _hits.resize(pathCount);
+    for (auto& queue : _queues) {
+        queue.resize(pathCount);
+    }
+    _shadows.resize(pathCount * std::max(1u, lightsPerHit));
+    
+    for (unsigned int sample = 0; sample < samplesPerPixel; sample++) {
+        unsigned int current = 0;
+        _queues[current].size = 0;
+        runStage(_timings.generate, pathCount, [&](unsigned int first, unsigned int end) {
+            generate(camera, buffer, first, end);
+        });
+        
+        for (unsigned int depth = 0; depth <= _maxDepth && _queues[current].size > 0; depth++) {
+            auto& queue = _queues[current];
+            auto& next = _queues[1 - current];
+            unsigned int queueSize = queue.size;
+            next.size = 0;
+            _shadows.size = 0;
+            _timings.extensionRays += queueSize;
+            
+            runStage(_timings.extend, queueSize, [&](unsigned int first, unsigned int end) {
+                extend(queue, first, end);
+            });
+            
+            runStage(_timings.material, queueSize, [&](unsigned int first, unsigned int end) {
+                evaluateMaterials(queue, next, depth, first, end);
+            });
+            
+            unsigned int shadowSize = _shadows.size;
+            _timings.shadowRays += shadowSize;
+            runStage(_timings.shadow, shadowSize, [&](unsigned int first, unsigned int end) {
+                traceShadows(first, end);
+            });
+            
+            runStage(_timings.accumulate, queueSize, [&](unsigned int first, unsigned int end) {
+                accumulateLight(queue, first, end);
+            });
+            
+            current = 1 - current;
+        }
+        
+        //every path covers its own pixel, so the film takes them in parallel too
+        runStage(_timings.accumulate, pathCount, [&](unsigned int first, unsigned int end) {
+            for (unsigned int i = first; i < end; i++) {
+                buffer.addSample(_paths[i].x, _paths[i].y, _paths[i].radiance);
+            }
+        });
+    }
+}
+
+void WavefrontIntegrator::runStage(std::chrono::nanoseconds& clock, unsigned int size, const Kernel& kernel) {
+    auto start = std::chrono::steady_clock::now();
+    if (size > 0) {
+        _parallelFor(size, kernel);
+    }
+    
+    clock += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+}
+
+double WavefrontIntegrator::uniform(PathState& path) const {
+    if (_sampler) {
+        return _sampler->sample(path.x, path.y, path.sampleIndex, path.dimension++);
+    }
+    
+    return std::uniform_real_distribution<double>(0.0, 1.0)(path.random);
+}
+
+void WavefrontIntegrator::generate(const Camera& camera, const AccumulationBuffer& buffer, unsigned int first, unsigned int end) {
+    for (unsigned int i = first; i < end; i++) {
+        auto& path = _paths[i];
+        path.x = i % buffer.width();
+        path.y = i / buffer.width();
+        path.sampleIndex = buffer.sampleCount(path.x, path.y);
+        path.dimension = 0;
+        path.random.seed(pathSeed(_seed, i, path.sampleIndex));
+        path.throughput = Colour(1.0, 1.0, 1.0);
+        path.radiance = Colour(0.0, 0.0, 0.0);
+        path.shadowCount = 0;
+        
+        auto offsetX = uniform(path);
+        auto offsetY = uniform(path);
+        //the lens and shutter only take dimensions when they're used, so other renders keep their sequence
+        auto lensU = camera.isPinhole() ? 0.5 : uniform(path);
+        auto lensV = camera.isPinhole() ? 0.5 : uniform(path);
+        auto ray = camera.rayForPixel(path.x, path.y, offsetX, offsetY, lensU, lensV);
+        if (camera.hasMotionBlur()) {
+            ray.setTime(camera.shutterTime(uniform(path)));
+        }
+        
+        _queues[0].push(ray, i);
+    }
+}
+
+void WavefrontIntegrator::extend(const RayQueue& queue, unsigned int first, unsigned int end) {
+    for (unsigned int i = first; i < end; i++) {
+        _hits[queue.paths[i]] = _world.hitValuesAt(queue.ray(i));
+    }
+}
+
+void WavefrontIntegrator::evaluateMaterials(const RayQueue& queue, RayQueue& next, unsigned int depth, unsigned int first, unsigned int end) {
+    const auto* compiled = _world.compiledScene();
+    const auto* lightBvh = _world.lightBvh();
+    const auto& lights = _world.lights();
+    
+    for (unsigned int i = first; i < end; i++) {
+        auto index = queue.paths[i];
+        auto& path = _paths[index];
+        path.shadowCount = 0;
+        
+        const auto& values = _hits[index];
+        if (!values) {
+            continue;
+        }
+        
+        const auto* object = values->intersect.object;
+        auto material = object->materialAt(values->intersect);
+        auto surfaceColour = compiled ? compiled->colourAt(values->intersect, values->point) : material.colourAt(object, values->point, values->intersect.time);
+        path.radiance = path.radiance + path.throughput * material._emissive;
+        
+        //next event estimation, queued here and resolved by the shadow stage
+        auto random = [&]() { return uniform(path); };
+        SurfaceLobes lobes(material, surfaceColour);
+        if (!lobes.empty()) {
+            auto queueLight = [&](unsigned int slot, unsigned int light, double scale) {
+                auto target = lightTarget(*lights[light], values->overPoint, random);
+                auto direct = unshadowedPathLight(*lights[light], target, *values, lobes);
+                _shadows.lights[slot] = direct ? light : noLight;
+                _shadows.visible[slot] = 0;
+                if (!direct) {
+                    return;
+                }
+                
+                Colour contribution = path.throughput * *direct * scale;
+                _shadows.originX[slot] = values->overPoint.x();
+                _shadows.originY[slot] = values->overPoint.y();
+                _shadows.originZ[slot] = values->overPoint.z();
+                _shadows.targetX[slot] = target.x();
+                _shadows.targetY[slot] = target.y();
+                _shadows.targetZ[slot] = target.z();
+                _shadows.times[slot] = values->intersect.time;
+                _shadows.red[slot] = contribution.red();
+                _shadows.green[slot] = contribution.green();
+                _shadows.blue[slot] = contribution.blue();
+            };
+            
+            if (lightBvh) {
+                //one light per hit picked by estimated contribution, weighted by how likely it was
+                auto picked = lightBvh->sample(values->overPoint, values->normal, uniform(path));
+                if (picked) {
+                    path.shadowFirst = _shadows.claim(1);
+                    path.shadowCount = 1;
+                    queueLight(path.shadowFirst, picked->light, 1.0 / picked->pmf);
+                }
+            } else if (!lights.empty()) {
+                path.shadowCount = static_cast<unsigned int>(lights.size());
+                path.shadowFirst = _shadows.claim(path.shadowCount);
+                for (unsigned int light = 0; light < lights.size(); light++) {
+                    queueLight(path.shadowFirst + light, light, 1.0);
+                }
+            }
+        }
+        
+        Ray ray = queue.ray(i);
+        if (depth < _maxDepth && continuePath(depth, *values, material, lobes, random, path.throughput, ray)) {
+            next.push(ray, index);
+        }
+    }
+}
+
+void WavefrontIntegrator::traceShadows(unsigned int first, unsigned int end) {
+    const auto& lights = _world.lights();
+    
+    for (unsigned int i = first; i < end; i++) {
+        if (_shadows.lights[i] == noLight) {
+            continue;
+        }
+        
+        auto origin = create_point(_shadows.originX[i], _shadows.originY[i], _shadows.originZ[i]);
+        auto target = create_point(_shadows.targetX[i], _shadows.targetY[i], _shadows.targetZ[i]);
+        _shadows.visible[i] = !_world.isOccluded(origin, target, *lights[_shadows.lights[i]], _shadows.times[i]);
+    }
+}
+
+void WavefrontIntegrator::accumulateLight(const RayQueue& queue, unsigned int first, unsigned int end) {
+    for (unsigned int i = first; i < end; i++) {
+        auto& path = _paths[queue.paths[i]];
+        for (unsigned int slot = path.shadowFirst; slot < path.shadowFirst + path.shadowCount; slot++) {
+            if (_shadows.visible[slot]) {
+                path.radiance = path.radiance + Colour(_shadows.red[slot], _shadows.green[slot], _shadows.blue[slot]);
+            }
+        }
+        
+        path.shadowCount = 0;
+    }
+}
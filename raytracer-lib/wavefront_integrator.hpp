@@ -0,0 +1,138 @@
+//
+//  wavefront_integrator.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef wavefront_integrator_hpp
+#define wavefront_integrator_hpp
+
+#include "accumulation_buffer.hpp"
+#include "camera.hpp"
+#include "colour.hpp"
+#include "intersection.hpp"
+#include "sampler.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace rtlib {
+
+class World;
+
+//The PathIntegrator's paths traced a bounce at a time for every pixel at once. Each
+//bounce is a sequence of stages, each a kernel over a queue: generate makes the camera
+//rays, extend finds their closest hits, material adds emission and queues a shadow ray
+//per light along with the continuation ray, shadow tests the shadow rays for any hit
+//and accumulate adds the light that got through. Queues are SoA and filled through
+//atomic slots, so every stage can be split across threads with setParallelFor.
+//
+//Paths draw their random numbers from the sampler as PathIntegrator does, so with the
+//same sampler both give the same image. Without one each path seeds its own generator.
+class WavefrontIntegrator {
+public:
+    typedef std::function<void(unsigned int first, unsigned int end)> Kernel;
+    
+    //runs the kernel over [0, size) split however it likes, the default is one call on this thread
+    typedef std::function<void(unsigned int size, const Kernel& kernel)> ParallelFor;
+    
+    struct StageTimings {
+        std::chrono::nanoseconds generate{0};
+        std::chrono::nanoseconds extend{0};
+        std::chrono::nanoseconds material{0};
+        std::chrono::nanoseconds shadow{0};
+        std::chrono::nanoseconds accumulate{0};
+        unsigned long long extensionRays = 0;
+        unsigned long long shadowRays = 0;
+    };
+    
+private:
+    static constexpr unsigned int noLight = std::numeric_limits<unsigned int>::max();
+    
+    struct RayQueue {
+        std::vector<double> originX, originY, originZ;
+        std::vector<double> directionX, directionY, directionZ;
+        std::vector<double> times;
+        std::vector<unsigned int> paths;
+        std::atomic<unsigned int> size{0};
+        
+        void resize(unsigned int capacity);
+        void push(const Ray& ray, unsigned int path);
+        Ray ray(unsigned int index) const;
+    };
+    
+    struct ShadowQueue {
+        std::vector<double> originX, originY, originZ;
+        std::vector<double> targetX, targetY, targetZ;
+        std::vector<double> times;
+        std::vector<unsigned int> lights; //noLight where the surface faces away and there's nothing to test
+        std::vector<double> red, green, blue; //light arriving if unblocked, already scaled by the throughput
+        std::vector<unsigned char> visible;
+        std::atomic<unsigned int> size{0};
+        
+        void resize(unsigned int capacity);
+        unsigned int claim(unsigned int count);
+    };
+    
+    struct PathState {
+        unsigned int x;
+        unsigned int y;
+        unsigned int sampleIndex;
+        unsigned int dimension;
+        std::minstd_rand random;
+        Colour throughput;
+        Colour radiance;
+        unsigned int shadowFirst;
+        unsigned int shadowCount;
+    };
+    
+    const World& _world;
+    unsigned int _maxDepth;
+    unsigned int _seed;
+    std::shared_ptr<const Sampler> _sampler;
+    ParallelFor _parallelFor;
+    StageTimings _timings;
+    
+    std::vector<PathState> _paths;
+    std::vector<std::optional<IntersectValues>> _hits;
+    std::array<RayQueue, 2> _queues; //this bounce's rays and the next's
+    ShadowQueue _shadows;
+    
+public:
+    WavefrontIntegrator(const World& world, unsigned int maxDepth = 8, unsigned int seed = 1);
+    
+    unsigned int maxDepth() const;
+    
+    const Sampler* sampler() const;
+    void setSampler(std::shared_ptr<const Sampler> sampler);
+    void setParallelFor(ParallelFor parallelFor);
+    
+    //summed over every accumulate since the last reset
+    const StageTimings& timings() const;
+    void resetTimings();
+    
+    //adds samplesPerPixel samples to every pixel, the same samples PathIntegrator::accumulate adds
+    void accumulate(const Camera& camera, AccumulationBuffer& buffer, unsigned int samplesPerPixel = 1);
+    
+private:
+    void runStage(std::chrono::nanoseconds& clock, unsigned int size, const Kernel& kernel);
+    double uniform(PathState& path) const;
+    
+    void generate(const Camera& camera, const AccumulationBuffer& buffer, unsigned int first, unsigned int end);
+    void extend(const RayQueue& queue, unsigned int first, unsigned int end);
+    void evaluateMaterials(const RayQueue& queue, RayQueue& next, unsigned int depth, unsigned int first, unsigned int end);
+    void traceShadows(unsigned int first, unsigned int end);
+    void accumulateLight(const RayQueue& queue, unsigned int first, unsigned int end);
+};
+
+}
+
+#endif /* wavefront_integrator_hpp */
@@ -0,0 +1,166 @@
+//
+//  wide_bvh.cpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include "wide_bvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace rtlib;
+
+namespace {
+
+const int minimumExponent = -100;
+
+//widen the far distance slightly so rounding in the float slab test can't drop a grazing hit
+const float farScale = 1.0f + 1e-5f;
+
+float dequantise(float origin, uint8_t q, float scale) {
+    return origin + static_cast<float>(q) * scale;
+}
+
+}
+
+WideBVH::WideBVH(const BVH& bvh) :
+    _primitives(bvh.primitives())
+{
+    if (bvh.root() != BVH::noNode) {
+        _nodes.reserve(bvh.liveNodeCount() / 2 + 1);
+        collapse(bvh, bvh.root());
+    }
+}
+
+const std::vector<WideBVH::Node>& WideBVH::nodes() const {
+    return _nodes;
+}
+
+std::size_t WideBVH::memoryFootprint() const {
+    return _nodes.size() * sizeof(Node) + _primitives.size() * sizeof(unsigned int);
+}
+
+uint32_t WideBVH::collapse(const BVH& bvh, unsigned int binaryNode) {
+    const auto& binaryNodes = bvh.nodes();
+
+    //open the largest interior child until the node is full or only leaves remain
+    std::vector<unsigned int> children;
+    if (binaryNodes[binaryNode].leaf) {
+        children.push_back(binaryNode);
+    } else {
+        children.push_back(binaryNodes[binaryNode].left);
+        children.push_back(binaryNodes[binaryNode].right);
+    }
+
+    while (children.size() < width) {
+        int largest = -1;
+        double largestArea = -1.0;
+        for (unsigned int i = 0; i < children.size(); i++) {
+            const auto& child = binaryNodes[children[i]];
+            if (!child.leaf && child.bounds.surfaceArea() > largestArea) {
+                largest = i;
+                largestArea = child.bounds.surfaceArea();
+            }
+        }
+
+        if (largest < 0) {
+            break;
+        }
+
+        auto opened = children[largest];
+        children[largest] = binaryNodes[opened].left;
+        children.push_back(binaryNodes[opened].right);
+    }
+
+    BoundingBox bounds;
+    for (auto child : children) {
+        bounds.addBox(binaryNodes[child].bounds);
+    }
+
+    Node node = {};
+    node.childCount = static_cast<uint8_t>(children.size());
+
+    for (unsigned int axis = 0; axis < 3; axis++) {
+        auto min = bounds.min()[axis];
+        auto max = bounds.max()[axis];
+
+        auto origin = static_cast<float>(min);
+        if (origin > min) {
+            origin = std::nextafter(origin, -std::numeric_limits<float>::infinity());
+        }
+
+        //keep one step of headroom so the upper bound can always be rounded outward
+        auto extent = max - origin;
+        auto exponent = extent > 0.0 ? static_cast<int>(std::ceil(std::log2(extent / 254.0))) : minimumExponent;
+        exponent = std::clamp(exponent, minimumExponent, static_cast<int>(std::numeric_limits<int8_t>::max()));
+        auto scale = std::ldexp(1.0f, exponent);
+
+        node.origin[axis] = origin;
+        node.exponent[axis] = static_cast<int8_t>(exponent);
+
+        for (unsigned int i = 0; i < children.size(); i++) {
+            const auto& childBounds = binaryNodes[children[i]].bounds;
+            auto childMin = childBounds.min()[axis];
+            auto childMax = childBounds.max()[axis];
+
+            auto lower = static_cast<int>(std::floor((childMin - origin) / scale));
+            lower = std::clamp(lower, 0, 255);
+            while (lower > 0 && dequantise(origin, lower, scale) > childMin) {
+                lower--;
+            }
+
+            auto upper = static_cast<int>(std::ceil((childMax - origin) / scale));
+            upper = std::clamp(upper, 0, 255);
+            while (upper < 255 && dequantise(origin, upper, scale) < childMax) {
+                upper++;
+            }
+
+            node.lower[axis][i] = static_cast<uint8_t>(lower);
+            node.upper[axis][i] = static_cast<uint8_t>(upper);
+        }
+    }
+
+    auto index = static_cast<uint32_t>(_nodes.size());
+    _nodes.push_back(node);
+
+    for (unsigned int i = 0; i < children.size(); i++) {
+        const auto& child = binaryNodes[children[i]];
+        if (child.leaf) {
+            if (child.count > std::numeric_limits<uint8_t>::max()) {
+                throw std::runtime_error("wide bvh leaves are limited to 255 primitives");
+            }
+
+            _nodes[index].child[i] = child.first;
+            _nodes[index].leafCount[i] = static_cast<uint8_t>(child.count);
+        } else {
+            auto wideChild = collapse(bvh, children[i]);
+            _nodes[index].child[i] = wideChild;
+            _nodes[index].leafCount[i] = 0;
+        }
+    }
+
+    return index;
+}
+
+simd_int8 WideBVH::intersectChildren(const Node& node, const simd_float3& origin, const simd_float3& inverseDirection, float maxDistance) const {
+    simd_float8 tNear = 0.0f;
+    simd_float8 tFar = maxDistance;
+
+    for (int axis = 0; axis < 3; axis++) {
+        auto scale = std::ldexp(1.0f, node.exponent[axis]);
+        simd_float8 lower = node.origin[axis] + simd_float(node.lower[axis]) * scale;
+        simd_float8 upper = node.origin[axis] + simd_float(node.upper[axis]) * scale;
+
+        simd_float8 t0 = (lower - origin[axis]) * inverseDirection[axis];
+        simd_float8 t1 = (upper - origin[axis]) * inverseDirection[axis];
+        tNear = simd_max(tNear, simd_min(t0, t1));
+        tFar = simd_min(tFar, simd_max(t0, t1));
+    }
+
+    const simd_int8 lanes = simd_make_int8(0, 1, 2, 3, 4, 5, 6, 7);
+    return (tNear <= tFar * farScale) & (lanes < static_cast<int>(node.childCount));
+}
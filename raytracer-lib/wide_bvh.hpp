@@ -0,0 +1,110 @@
+//
+//  wide_bvh.hpp
+//  raytracer-lib
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#ifndef wide_bvh_hpp
+#define wide_bvh_hpp
+
+#include "bvh.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <simd/simd.h>
+#include <vector>
+
+namespace rtlib {
+
+//Eight-wide hierarchy collapsed from a binary BVH. Child boxes are stored as 8 bit
+//offsets from the node origin in power of two steps, so a node holding eight
+//children is smaller than a single binary node, and all eight boxes are slab
+//tested together with simd_float8.
+class WideBVH {
+public:
+    static constexpr unsigned int width = 8;
+
+    struct Node {
+        simd_uchar8 lower[3]; //quantised child bounds per axis, dequantised as origin + q * 2^exponent
+        simd_uchar8 upper[3];
+        float origin[3];
+        int8_t exponent[3];
+        uint8_t childCount;
+        uint32_t child[width]; //wide node index for interior children, first primitive for leaves
+        uint8_t leafCount[width]; //zero for interior children
+    };
+
+private:
+    std::vector<Node> _nodes;
+    std::vector<unsigned int> _primitives;
+
+public:
+    WideBVH(const BVH& bvh);
+
+    const std::vector<Node>& nodes() const;
+    std::size_t memoryFootprint() const;
+
+    //visitors as for BVH::traverse, returns the number of nodes visited
+    template<typename Function>
+    unsigned int traverse(const Ray& ray, double maxDistance, Function visitPrimitive) const;
+
+private:
+    uint32_t collapse(const BVH& bvh, unsigned int binaryNode);
+    simd_int8 intersectChildren(const Node& node, const simd_float3& origin, const simd_float3& inverseDirection, float maxDistance) const;
+};
+
+template<typename Function>
+unsigned int WideBVH::traverse(const Ray& ray, double maxDistance, Function visitPrimitive) const {
+    if (_nodes.empty()) {
+        return 0;
+    }
+
+    auto direction = ray.direction();
+    simd_float3 origin = simd_make_float3(ray.origin().x(), ray.origin().y(), ray.origin().z());
+    simd_float3 inverseDirection;
+    for (int axis = 0; axis < 3; axis++) {
+        //avoid 0 * inf nans in the slab test for axis aligned rays
+        auto component = static_cast<float>(direction[axis]);
+        if (std::abs(component) < 1e-20f) {
+            component = std::copysign(1e-20f, component);
+        }
+        inverseDirection[axis] = 1.0f / component;
+    }
+
+    auto distance = static_cast<float>(std::min(maxDistance, 3.0e38));
+
+    uint32_t stack[64 * width];
+    unsigned int stackSize = 0;
+    unsigned int visited = 0;
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const auto& node = _nodes[stack[--stackSize]];
+        visited++;
+        auto hits = intersectChildren(node, origin, inverseDirection, distance);
+
+        for (unsigned int i = 0; i < node.childCount; i++) {
+            if (!hits[i]) {
+                continue;
+            }
+
+            if (node.leafCount[i] == 0) {
+                stack[stackSize++] = node.child[i];
+            } else {
+                for (unsigned int p = node.child[i]; p < node.child[i] + node.leafCount[i]; p++) {
+                    if (visitEndsTraversal(visitPrimitive, _primitives[p])) {
+                        return visited;
+                    }
+                }
+            }
+        }
+    }
+
+    return visited;
+}
+
+}
+
+#endif /* wide_bvh_hpp */
@@ -7,6 +7,7 @@
 
 #include "world.hpp"
 
+#include "integrator.hpp"
 #include "lighting.hpp"
 #include "object.hpp"
 #include "ray.hpp"
@@ -14,15 +15,73 @@
 #include "transformations.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
 
 using namespace rtlib;
 
+namespace rtlib {
+
+//only written by the thread it belongs to, and kept off other threads' cache lines
+struct alignas(64) OccluderCounters {
+    std::atomic<unsigned long long> queries{0};
+    std::atomic<unsigned long long> hits{0};
+};
+
+}
+
+namespace {
+
+std::atomic<unsigned long long> nextWorldId(1);
+
+struct OccluderCache {
+    unsigned long long world = 0;
+    std::unordered_map<const Light*, unsigned int> lastOccluder; //object index, only ever a hint
+    OccluderCounters* counters = nullptr; //owned by the world
+};
+
+thread_local OccluderCache occluderCache;
+
+//a plain load and store, no locked add, as only the owning thread writes
+void count(std::atomic<unsigned long long>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+bool anyBefore(const Intersections& hits, double distance) {
+    return std::any_of(hits.begin(), hits.end(), [distance](const Intersect& hit) {
+        return hit.t >= 0.0 && hit.t < distance;
+    });
+}
+
+}
+
+double OccluderCacheStats::hitRate() const {
+    return queries > 0 ? static_cast<double>(hits) / queries : 0.0;
+}
+
+World::World() :
+    _bvhObjectCount(0),
+    _bvhEpoch(0),
+    _compiledEpoch(0),
+    _id(nextWorldId++),
+    _occluderCacheEnabled(true)
+{
+}
+
+World::~World() {}
+
 std::vector<LightPtr>& World::lights() {
     return _lights;
 }
 
+const std::vector<LightPtr>& World::lights() const {
+    return _lights;
+}
+
 void World::addLight(LightPtr light) {
     _lights.push_back(std::move(light));
+    _lightBvh.reset();
 }
 
 std::vector<ObjectPtr>& World::objects() {
@@ -31,18 +90,194 @@ std::vector<ObjectPtr>& World::objects() {
 
 void World::addObject(ObjectPtr object) {
     _objects.push_back(std::move(object));
+    _bvh.reset();
+    _wideBvh.reset();
+    _compiled.reset();
+}
+
+void World::buildBVH(unsigned int maxLeafSize, BVHLayout layout) {
+    _bvhPrimitives.clear();
+    _bvhObjectCount = 0;
+    _unboundedObjects.clear();
+    
+    std::vector<BoundingBox> bounds;
+    for (unsigned int i = 0; i < _objects.size(); i++) {
+        auto objectBounds = _objects[i]->bounds();
+        if (objectBounds.finite()) {
+            auto version = _objects[i]->transformVersion();
+            _bvhObjectCount++;
+            
+            //leaf ranges go in as primitives of their own, so the tree splits them with everything else
+            auto ranges = _objects[i]->primitiveRanges();
+            if (ranges.empty()) {
+                _bvhPrimitives.push_back({i, 0, 0, version});
+                bounds.push_back(objectBounds);
+            }
+            
+            for (const auto& range : ranges) {
+                _bvhPrimitives.push_back({i, range.first, range.count, version});
+                bounds.push_back(range.bounds);
+            }
+        } else {
+            //planes and other unbounded objects would swallow the whole tree, test them directly
+            _unboundedObjects.push_back(i);
+        }
+    }
+    
+    _bvh = std::make_unique<BVH>(std::move(bounds), maxLeafSize);
+    _bvhEpoch = Object::transformEpoch();
+    
+    //the binary tree is kept alongside the wide one as it is what gets refit
+    if (layout == BVHLayout::Wide) {
+        _wideBvh = std::make_unique<WideBVH>(*_bvh);
+    } else {
+        _wideBvh.reset();
+    }
+}
+
+unsigned int World::updateBVH(double rebuildThreshold) {
+    if (_compiled) {
+        if (_compiled->holds(_objects)) {
+            _compiled->update();
+            _compiledEpoch = Object::transformEpoch();
+        } else {
+            compile();
+        }
+    }
+    
+    if (!_bvh) {
+        buildBVH();
+        return 1;
+    } else if (_objects.size() != _bvhObjectCount + _unboundedObjects.size()) {
+        buildBVH(_bvh->maxLeafSize(), _wideBvh ? BVHLayout::Wide : BVHLayout::Binary);
+        return 1;
+    }
+    
+    _bvhEpoch = Object::transformEpoch();
+    std::vector<unsigned int> moved;
+    std::unordered_map<unsigned int, std::vector<Object::PrimitiveRange>> movedRanges;
+    for (unsigned int i = 0; i < _bvhPrimitives.size(); i++) {
+        auto& primitive = _bvhPrimitives[i];
+        const auto& object = _objects[primitive.object];
+        auto version = object->transformVersion();
+        if (version == primitive.transformVersion) {
+            continue;
+        }
+        
+        auto bounds = object->bounds();
+        auto found = movedRanges.find(primitive.object);
+        if (found == movedRanges.end()) {
+            found = movedRanges.emplace(primitive.object, object->primitiveRanges()).first;
+            
+            //an object's ranges sit together from its first primitive, here, and only refit
+            //while it has as many as before, so a rebuilt set with new leaves starts again
+            unsigned int held = 0;
+            while (i + held < _bvhPrimitives.size() && _bvhPrimitives[i + held].object == primitive.object && _bvhPrimitives[i + held].count > 0) {
+                held++;
+            }
+            
+            if (held != found->second.size()) {
+                bounds = BoundingBox::infinite();
+            }
+        }
+        
+        if (primitive.count > 0 && bounds.finite()) {
+            auto range = std::find_if(found->second.begin(), found->second.end(), [&primitive](const Object::PrimitiveRange& range) {
+                return range.first == primitive.first && range.count == primitive.count;
+            });
+            bounds = range != found->second.end() ? range->bounds : BoundingBox::infinite();
+        }
+        
+        if (!bounds.finite()) {
+            //an object moved out of the bvh's reach or changed its leaves, start again
+            buildBVH(_bvh->maxLeafSize(), _wideBvh ? BVHLayout::Wide : BVHLayout::Binary);
+            return 1;
+        }
+        
+        primitive.transformVersion = version;
+        _bvh->setPrimitiveBounds(i, bounds);
+        moved.push_back(i);
+    }
+    
+    if (moved.empty()) {
+        return 0;
+    }
+    
+    _bvh->refit(moved);
+    auto rebuilt = _bvh->rebuildDegraded(rebuildThreshold);
+    
+    //collapsing is linear in the node count, cheap next to rendering a frame
+    if (_wideBvh) {
+        _wideBvh = std::make_unique<WideBVH>(*_bvh);
+    }
+    
+    return rebuilt;
+}
+
+const BVH* World::bvh() const {
+    return _bvh.get();
+}
+
+const WideBVH* World::wideBvh() const {
+    return _wideBvh.get();
+}
+
+void World::compile() {
+    _compiled = std::make_unique<CompiledScene>(_objects);
+    _compiledEpoch = Object::transformEpoch();
+}
+
+const CompiledScene* World::compiledScene() const {
+    return _compiled.get();
+}
+
+void World::buildLightBVH() {
+    _lightBvh = std::make_unique<LightBVH>(_lights);
+}
+
+const LightBVH* World::lightBvh() const {
+    return _lightBvh.get();
+}
+
+SceneFeatures World::features() const {
+    SceneFeatures features;
+    features.reflection = false;
+    features.transparency = false;
+    features.patterns = false;
+    
+    for (const auto& object : _objects) {
+        for (const auto& material : object->materials()) {
+            features.reflection = features.reflection || material._reflective > 0.0;
+            features.transparency = features.transparency || material._transparency > 0.0;
+            features.patterns = features.patterns || material._pattern;
+        }
+    }
+    
+    return features;
 }
 
 Colour World::colourAt(const Ray &ray, unsigned int remaining) const {
-    auto intersects = this->intersects(ray);
+    //called per ray, so this stays on the general kernel rather than scanning the scene each time
+    return Integrator(*this, SceneFeatures()).colourAt(ray, remaining);
+}
+
+std::optional<IntersectValues> World::hitValuesAt(const Ray& ray) const {
+    return hitValues(ray, intersects(ray));
+}
+
+std::optional<IntersectValues> World::hitValuesAt(const Ray& ray, const std::vector<unsigned int>& candidates) const {
+    return hitValues(ray, intersects(ray, candidates));
+}
+
+std::optional<IntersectValues> World::hitValues(const Ray& ray, const Intersections& intersects) const {
     auto rayHit = getFirstHit(intersects);
-    if (rayHit) {
-        auto values = IntersectValues(*rayHit, ray, intersects);
-        auto colour = shadeHits(values, remaining);
-        return colour;
-    } else {
-        return Colour();
+    if (!rayHit) {
+        return std::nullopt;
     }
+    
+    return _compiled ?
+        IntersectValues(*rayHit, ray, intersects, _compiled->normalAt(*rayHit, ray.positionAt(rayHit->t))) :
+        IntersectValues(*rayHit, ray, intersects);
 }
 
 Colour World::reflectedColourAt(const IntersectValues &values, unsigned int remaining) const {
@@ -52,45 +287,130 @@ Colour World::reflectedColourAt(const IntersectValues &values, unsigned int rema
     
     remaining--;
     
-    if (values.intersect.object->material()._reflective == 0.0) {
+    if (values.intersect.object->materialAt(values.intersect)._reflective == 0.0) {
         return Colour(0.0, 0.0, 0.0);
     }
     
-    auto reflectRay = Ray(values.overPoint, values.reflectionVector);
+    auto reflectRay = Ray(values.overPoint, values.reflectionVector(), values.intersect.time);
     auto colour = colourAt(reflectRay, remaining);
-    auto reflectColour = colour * values.intersect.object->material()._reflective;
+    auto reflectColour = colour * values.intersect.object->materialAt(values.intersect)._reflective;
     
     return reflectColour;
 }
 
 Colour World::refractedColourAt(const IntersectValues &values, unsigned int remaining) const {
-    if (values.intersect.object->material()._transparency == 0.0 ||
+    if (values.intersect.object->materialAt(values.intersect)._transparency == 0.0 ||
         remaining == 0) {
         return Colour(0.0, 0.0, 0.0);
     }
     
-    //snells law to determine total internal refraction
-    auto nRatio = values.refractiveIndexN1 / values.refractiveIndexN2;
-    auto cosI = Tuple::dot(values.vectorToEye, values.normal);
-    auto sin2t = nRatio * nRatio * (1 - cosI * cosI);
-    if (sin2t > 1.0) {
+    auto refractRay = refractedRay(values);
+    if (!refractRay) {
         return Colour(0.0, 0.0, 0.0);
     }
     
-    auto cosT = std::sqrt(1.0 - sin2t);
-    auto direction = values.normal * (nRatio * cosI - cosT) - values.vectorToEye * nRatio;
-    auto refractRay = Ray(values.underPoint, direction);
-    auto colour = colourAt(refractRay, remaining) * values.intersect.object->material()._transparency;
+    auto colour = colourAt(*refractRay, remaining) * values.intersect.object->materialAt(values.intersect)._transparency;
     
     return colour;
 }
 
+void World::checkBVH() const {
+    if (_objects.size() != _bvhObjectCount + _unboundedObjects.size()) {
+        throw std::logic_error("objects added since the BVH was built");
+    }
+    
+    //the epoch is shared by every object in every world, only when it changes are this world's objects looked at
+    auto epoch = Object::transformEpoch();
+    if (epoch == _bvhEpoch.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    for (const auto& primitive : _bvhPrimitives) {
+        if (_objects[primitive.object]->transformVersion() != primitive.transformVersion) {
+            throw std::logic_error("objects moved since the BVH was built, call updateBVH");
+        }
+    }
+    
+    _bvhEpoch.store(epoch, std::memory_order_relaxed);
+}
+
+void World::checkCompiled() const {
+    if (_objects.size() != _compiled->size()) {
+        throw std::logic_error("objects added since the scene was compiled");
+    }
+    
+    auto epoch = Object::transformEpoch();
+    if (epoch == _compiledEpoch.load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    if (!_compiled->holds(_objects) || _compiled->moved()) {
+        throw std::logic_error("objects moved or replaced since the scene was compiled, call updateBVH");
+    }
+    
+    _compiledEpoch.store(epoch, std::memory_order_relaxed);
+}
+
 Intersections World::intersects(const Ray& ray) const {
     Intersections allHits;
     
-    for (auto& obj : _objects) {
-        auto hits = obj->intersects(ray);
-        allHits.insert(std::end(allHits), std::begin(hits), std::end(hits));
+    if (_compiled) {
+        checkCompiled();
+    }
+    
+    if (_bvh) {
+        checkBVH();
+        auto visit = [&](unsigned int primitive) {
+            intersectPrimitive(primitive, ray, allHits);
+        };
+        
+        //objects entirely behind the ray origin are culled, their hits can never be the first hit
+        //and enter/exit in pairs so they don't affect the refraction containers either
+        if (_wideBvh) {
+            _wideBvh->traverse(ray, std::numeric_limits<double>::infinity(), visit);
+        } else {
+            _bvh->traverse(ray, std::numeric_limits<double>::infinity(), visit);
+        }
+        
+        for (auto index : _unboundedObjects) {
+            intersectObject(index, ray, allHits);
+        }
+    } else if (_compiled) {
+        allHits = _compiled->intersects(ray);
+    } else {
+        for (auto& obj : _objects) {
+            auto hits = obj->intersectsToFirstHit(ray);
+            allHits.insert(std::end(allHits), std::begin(hits), std::end(hits));
+        }
+    }
+    
+    std::sort(allHits.begin(), allHits.end(),
+        [](const Intersect& a, const Intersect& b) -> bool {
+            return a.t < b.t;
+        });
+    
+    return allHits;
+}
+
+std::vector<unsigned int> World::objectsInFrustum(const Frustum& frustum) const {
+    std::vector<unsigned int> candidates;
+    for (unsigned int index = 0; index < _objects.size(); index++) {
+        if (frustum.intersects(_objects[index]->bounds())) {
+            candidates.push_back(index);
+        }
+    }
+    
+    return candidates;
+}
+
+Intersections World::intersects(const Ray& ray, const std::vector<unsigned int>& candidates) const {
+    if (_compiled) {
+        checkCompiled();
+    }
+    
+    Intersections allHits;
+    for (auto index : candidates) {
+        intersectObject(index, ray, allHits);
     }
     
     std::sort(allHits.begin(), allHits.end(),
@@ -102,11 +422,11 @@ Intersections World::intersects(const Ray& ray) const {
 }
 
 Colour World::shadeHits(IntersectValues values, unsigned int remaining) const {
-    auto surfaceColour = _lights.front()->lightPoint(values.intersect.object, values.point, values.vectorToEye, values.normal, isShadowed(values.overPoint));
+    auto material = values.intersect.object->materialAt(values.intersect);
+    auto surfaceColour = surfaceColourAt(values);
     auto reflectedColour = reflectedColourAt(values, remaining);
     auto refractedColour = refractedColourAt(values, remaining);
     
-    auto material = values.intersect.object->material();
     if (material._reflective > 0.0 && material._transparency > 0.0) {
         auto reflectance = schlickReflectance(values);
         return surfaceColour + reflectedColour * reflectance + refractedColour * (1 - reflectance);
@@ -115,6 +435,22 @@ Colour World::shadeHits(IntersectValues values, unsigned int remaining) const {
     }
 }
 
+Colour World::surfaceColourAt(const IntersectValues& values) const {
+    auto object = values.intersect.object;
+    auto material = object->materialAt(values.intersect);
+    auto patternColour = _compiled ? _compiled->colourAt(values.intersect, values.point) : material.colourAt(object, values.point, values.intersect.time);
+    return surfaceColourAt(values, material, patternColour);
+}
+
+Colour World::surfaceColourAt(const IntersectValues& values, const Material& material, const Colour& surfaceColour) const {
+    if (_lights.size() > 1) {
+        throw std::runtime_error("only 1 light supported");
+    }
+    
+    const auto& light = *_lights.front();
+    return light.lightPoint(material, surfaceColour, values.point, values.vectorToEye, values.normal, lightVisibility(light, values.overPoint, values.intersect.time));
+}
+
 bool World::isShadowed(const Tuple &point) const {
     if (_lights.size() > 1) {
         throw std::runtime_error("only 1 light supported");
@@ -122,15 +458,181 @@ bool World::isShadowed(const Tuple &point) const {
         return false;
     }
     
-    auto pointToLightVector = _lights.front()->origin() - point;
-    auto distancePointToLight = pointToLightVector.magnitude();
-    auto normalisedPointToLightVector = pointToLightVector.normalised();
-    auto ray = Ray(point, normalisedPointToLightVector);
+    return isOccluded(point, _lights.front()->origin(), *_lights.front());
+}
+
+double World::lightVisibility(const Light& light, const Tuple& point, double time) const {
+    auto samples = light.sampleCount();
+    auto initial = light.initialSamples();
+    unsigned int visible = 0;
+    for (unsigned int i = 0; i < initial; i++) {
+        if (!isOccluded(point, light.samplePoint(i, point), light, time)) {
+            visible++;
+        }
+    }
+    
+    //agreeing samples mean fully lit or in the umbra, only penumbrae pay for the rest
+    if (visible == 0 || visible == initial) {
+        return visible == 0 ? 0.0 : 1.0;
+    }
+    
+    for (unsigned int i = initial; i < samples; i++) {
+        if (!isOccluded(point, light.samplePoint(i, point), light, time)) {
+            visible++;
+        }
+    }
+    
+    return static_cast<double>(visible) / samples;
+}
+
+bool World::isOccluded(const Tuple& point, const Tuple& target, double time) const {
+    auto pointToTargetVector = target - point;
+    auto distancePointToTarget = pointToTargetVector.magnitude();
+    auto normalisedPointToTargetVector = pointToTargetVector.normalised();
+    auto ray = Ray(point, normalisedPointToTargetVector, time);
     
     auto intersections = intersects(ray);
     auto hit = rtlib::getFirstHit(intersections);
     
-    return hit && hit->t < distancePointToLight;
+    return hit && hit->t < distancePointToTarget;
+}
+
+bool World::isOccluded(const Tuple& point, const Tuple& target, const Light& light, double time) const {
+    auto toTarget = target - point;
+    auto distance = toTarget.magnitude();
+    auto ray = Ray(point, toTarget.normalised(), time);
+    
+    //the cached occluder is tested before findOccluder gets to check
+    if (_compiled) {
+        checkCompiled();
+    }
+    
+    if (!_occluderCacheEnabled) {
+        return findOccluder(ray, distance).has_value();
+    }
+    
+    if (occluderCache.world != _id) {
+        occluderCache.world = _id;
+        occluderCache.lastOccluder.clear();
+        occluderCache.counters = &threadOccluderCounters();
+    }
+    
+    count(occluderCache.counters->queries);
+    auto cached = occluderCache.lastOccluder.find(&light);
+    if (cached != occluderCache.lastOccluder.end() && cached->second < _objects.size() && blocks(cached->second, ray, distance)) {
+        count(occluderCache.counters->hits);
+        return true;
+    }
+    
+    auto occluder = findOccluder(ray, distance);
+    if (occluder) {
+        occluderCache.lastOccluder[&light] = *occluder;
+    }
+    
+    return occluder.has_value();
+}
+
+void World::setOccluderCacheEnabled(bool enabled) {
+    _occluderCacheEnabled = enabled;
+}
+
+OccluderCacheStats World::occluderCacheStats() const {
+    std::lock_guard<std::mutex> lock(_occluderCountersMutex);
+    OccluderCacheStats stats;
+    for (const auto& [thread, counters] : _occluderCounters) {
+        stats.queries += counters->queries.load(std::memory_order_relaxed);
+        stats.hits += counters->hits.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+void World::resetOccluderCacheStats() {
+    std::lock_guard<std::mutex> lock(_occluderCountersMutex);
+    for (const auto& [thread, counters] : _occluderCounters) {
+        counters->queries = 0;
+        counters->hits = 0;
+    }
+}
+
+OccluderCounters& World::threadOccluderCounters() const {
+    //only taken when a thread's cache switches world, never per query
+    std::lock_guard<std::mutex> lock(_occluderCountersMutex);
+    auto id = std::this_thread::get_id();
+    for (const auto& [thread, counters] : _occluderCounters) {
+        if (thread == id) {
+            return *counters;
+        }
+    }
+    
+    _occluderCounters.emplace_back(id, std::make_unique<OccluderCounters>());
+    return *_occluderCounters.back().second;
+}
+
+void World::intersectObject(unsigned int index, const Ray& ray, Intersections& hits) const {
+    if (_compiled) {
+        _compiled->intersects(index, ray, hits);
+    } else {
+        auto objectHits = _objects[index]->intersectsToFirstHit(ray);
+        hits.insert(std::end(hits), std::begin(objectHits), std::end(objectHits));
+    }
+}
+
+void World::intersectPrimitive(unsigned int primitive, const Ray& ray, Intersections& hits) const {
+    const auto& entry = _bvhPrimitives[primitive];
+    if (entry.count == 0) {
+        intersectObject(entry.object, ray, hits);
+    } else {
+        _objects[entry.object]->intersectsRange(ray, entry.first, entry.count, hits);
+    }
+}
+
+bool World::blocks(unsigned int index, const Ray& ray, double distance) const {
+    Intersections hits;
+    intersectObject(index, ray, hits);
+    return anyBefore(hits, distance);
+}
+
+std::optional<unsigned int> World::findOccluder(const Ray& ray, double distance) const {
+    //any blocking object will do, so the search and the traversal stop once one is found
+    std::optional<unsigned int> occluder;
+    auto test = [&](unsigned int index) {
+        if (!occluder && blocks(index, ray, distance)) {
+            occluder = index;
+        }
+    };
+    
+    if (_compiled) {
+        checkCompiled();
+    }
+    
+    if (_bvh) {
+        checkBVH();
+        auto visit = [&](unsigned int primitive) {
+            Intersections hits;
+            intersectPrimitive(primitive, ray, hits);
+            if (anyBefore(hits, distance)) {
+                occluder = _bvhPrimitives[primitive].object;
+            }
+            
+            return occluder.has_value();
+        };
+        
+        if (_wideBvh) {
+            _wideBvh->traverse(ray, distance, visit);
+        } else {
+            _bvh->traverse(ray, distance, visit);
+        }
+        
+        for (auto index : _unboundedObjects) {
+            test(index);
+        }
+    } else {
+        for (unsigned int index = 0; index < _objects.size(); index++) {
+            test(index);
+        }
+    }
+    
+    return occluder;
 }
 
 std::unique_ptr<World> World::defaultWorld() {
@@ -8,10 +8,18 @@
 #ifndef world_hpp
 #define world_hpp
 
+#include "bvh.hpp"
+#include "compiled_scene.hpp"
+#include "light_bvh.hpp"
 #include "object.hpp"
+#include "wide_bvh.hpp"
 
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace rtlib {
  
@@ -19,31 +27,134 @@ class Light;
 typedef std::unique_ptr<Light> LightPtr;
 class Object;
 typedef std::unique_ptr<Object> ObjectPtr;
+struct OccluderCounters;
+
+enum class BVHLayout {
+    Binary,
+    Wide //eight-wide quantised nodes, smaller and traversed with simd
+};
+
+//shadow queries answered by the occluder cache, summed over all threads
+struct OccluderCacheStats {
+    unsigned long long queries = 0;
+    unsigned long long hits = 0;
+    
+    double hitRate() const;
+};
+
+//which shading features any material in the scene uses, kernels specialised on these
+//skip the branches for the rest
+struct SceneFeatures {
+    bool reflection = true;
+    bool transparency = true;
+    bool patterns = true;
+};
 
 class World {
 private:
+    //a bounded object, or one of the leaf ranges a many primitive object hands over
+    struct BVHPrimitive {
+        unsigned int object;
+        unsigned int first;
+        unsigned int count; //0 for the whole object
+        unsigned int transformVersion;
+    };
+    
     std::vector<LightPtr> _lights;
     std::vector<ObjectPtr> _objects;
     
+    std::unique_ptr<BVH> _bvh;
+    std::unique_ptr<WideBVH> _wideBvh;
+    std::vector<BVHPrimitive> _bvhPrimitives;
+    unsigned int _bvhObjectCount;
+    std::vector<unsigned int> _unboundedObjects;
+    mutable std::atomic<unsigned long long> _bvhEpoch; //Object::transformEpoch when the bvh was last known current
+    
+    std::unique_ptr<CompiledScene> _compiled;
+    mutable std::atomic<unsigned long long> _compiledEpoch; //as _bvhEpoch, for the compiled scene's inverses
+    std::unique_ptr<LightBVH> _lightBvh;
+    
+    //each thread remembers per light the object that last blocked it, keyed by _id so
+    //a new world never picks up a dead one's entries
+    unsigned long long _id;
+    bool _occluderCacheEnabled;
+    
+    //cache stats are counted per thread, the thread's cache keeps a pointer to its own
+    mutable std::mutex _occluderCountersMutex;
+    mutable std::vector<std::pair<std::thread::id, std::unique_ptr<OccluderCounters>>> _occluderCounters;
+    
 public:
-    World() {}
-    ~World() {}
+    World();
+    ~World();
     
     std::vector<LightPtr>& lights();
+    const std::vector<LightPtr>& lights() const;
     void addLight(LightPtr light);
     
+    //objects added or replaced through here aren't in a built BVH or compiled scene until
+    //updateBVH, or buildBVH and compile, run again
     std::vector<ObjectPtr>& objects();
     void addObject(ObjectPtr object);
     
+    //the BVH holds object bounds as they were, call updateBVH after moving objects. Queries
+    //throw std::logic_error rather than miss hits if one has moved since
+    void buildBVH(unsigned int maxLeafSize = 4, BVHLayout layout = BVHLayout::Binary);
+    unsigned int updateBVH(double rebuildThreshold = 1.5);
+    const BVH* bvh() const;
+    const WideBVH* wideBvh() const;
+    
+    //the compiled scene keeps inverse transforms as they were, like the BVH's bounds it is
+    //brought up to date by updateBVH and queries throw std::logic_error while it is stale
+    void compile();
+    const CompiledScene* compiledScene() const;
+    
+    //lets integrators pick one light per hit instead of shading them all, rebuild after editing lights()
+    void buildLightBVH();
+    const LightBVH* lightBvh() const;
+    
+    //scans every material, once per render rather than per ray
+    SceneFeatures features() const;
+    
     Colour colourAt(const Ray& ray, unsigned int remaining = 5) const;
+    std::optional<IntersectValues> hitValuesAt(const Ray& ray) const;
     Colour reflectedColourAt(const IntersectValues& values, unsigned int remaining) const;
     Colour refractedColourAt(const IntersectValues& values, unsigned int remaining) const;
     
+    //sorted hits up to and including each object's first at or past t = 0, as
+    //Object::intersectsToFirstHit, which is everything the first hit's refraction needs
     Intersections intersects(const Ray& ray) const;
+    
+    //objects a ray inside the frustum could hit, unbounded ones always among them, so rays
+    //known to stay inside can test just these without a BVH
+    std::vector<unsigned int> objectsInFrustum(const Frustum& frustum) const;
+    Intersections intersects(const Ray& ray, const std::vector<unsigned int>& candidates) const;
+    std::optional<IntersectValues> hitValuesAt(const Ray& ray, const std::vector<unsigned int>& candidates) const;
+    
     Colour shadeHits(IntersectValues values, unsigned int remaining) const;
+    Colour surfaceColourAt(const IntersectValues& values) const; //direct lighting only
+    Colour surfaceColourAt(const IntersectValues& values, const Material& material, const Colour& surfaceColour) const;
     bool isShadowed(const Tuple& point) const;
     
+    //times are the shading ray's, so shadows come from where moving objects were
+    double lightVisibility(const Light& light, const Tuple& point, double time = 0.0) const;
+    bool isOccluded(const Tuple& point, const Tuple& target, double time = 0.0) const;
+    bool isOccluded(const Tuple& point, const Tuple& target, const Light& light, double time = 0.0) const; //tries the light's last occluder first
+    
+    void setOccluderCacheEnabled(bool enabled);
+    OccluderCacheStats occluderCacheStats() const;
+    void resetOccluderCacheStats(); //between renders, a thread mid query may keep its count
+    
     static std::unique_ptr<World> defaultWorld();
+    
+private:
+    void checkBVH() const;
+    void checkCompiled() const;
+    std::optional<IntersectValues> hitValues(const Ray& ray, const Intersections& intersects) const;
+    void intersectObject(unsigned int index, const Ray& ray, Intersections& hits) const;
+    void intersectPrimitive(unsigned int primitive, const Ray& ray, Intersections& hits) const;
+    bool blocks(unsigned int index, const Ray& ray, double distance) const;
+    std::optional<unsigned int> findOccluder(const Ray& ray, double distance) const;
+    OccluderCounters& threadOccluderCounters() const;
 };
 
 }
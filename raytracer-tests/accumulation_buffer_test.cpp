@@ -0,0 +1,55 @@
+//
+//  accumulation_buffer_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "accumulation_buffer.hpp"
+
+using namespace rtlib;
+
+namespace {
+
+TEST(AccumulationBufferTest, StartsEmpty) {
+    AccumulationBuffer buffer(4, 3);
+    EXPECT_EQ(buffer.width(), 4);
+    EXPECT_EQ(buffer.height(), 3);
+    EXPECT_EQ(buffer.sampleCount(2, 1), 0);
+    EXPECT_EQ(buffer.average(2, 1), Colour(0.0, 0.0, 0.0));
+}
+
+TEST(AccumulationBufferTest, AveragesSamples) {
+    AccumulationBuffer buffer(4, 3);
+    buffer.addSample(2, 1, Colour(1.0, 0.0, 0.5));
+    buffer.addSample(2, 1, Colour(0.0, 1.0, 0.5));
+    
+    EXPECT_EQ(buffer.sampleCount(2, 1), 2);
+    EXPECT_EQ(buffer.average(2, 1), Colour(0.5, 0.5, 0.5));
+    EXPECT_EQ(buffer.sampleCount(1, 2), 0);
+}
+
+TEST(AccumulationBufferTest, ResolvesIntoCanvas) {
+    AccumulationBuffer buffer(2, 2);
+    buffer.addSample(1, 0, Colour(0.25, 0.5, 1.0));
+    
+    Canvas canvas(2, 2);
+    buffer.resolve(canvas);
+    EXPECT_EQ(canvas.pixelAt(1, 0), Colour(0.25, 0.5, 1.0));
+    EXPECT_EQ(canvas.pixelAt(0, 1), Colour(0.0, 0.0, 0.0));
+    
+    Canvas wrongSize(3, 2);
+    EXPECT_THROW(buffer.resolve(wrongSize), std::runtime_error);
+}
+
+TEST(AccumulationBufferTest, ClearResetsSamples) {
+    AccumulationBuffer buffer(2, 2);
+    buffer.addSample(0, 0, Colour(1.0, 1.0, 1.0));
+    buffer.clear();
+    EXPECT_EQ(buffer.sampleCount(0, 0), 0);
+    EXPECT_EQ(buffer.average(0, 0), Colour(0.0, 0.0, 0.0));
+}
+
+}
@@ -0,0 +1,86 @@
+//
+//  antialiasing_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "antialiasing.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+//a vertical edge a quarter of the way into column 9 of a 20 pixel wide camera,
+//white to its left and black to its right
+AdaptiveAntialiaser::Trace edgeTrace(const Camera& camera) {
+    auto edge = 0.25 * camera.pixelSize();
+    return [edge](const Ray& ray) {
+        return ray.direction().x() / -ray.direction().z() > edge ? Colour(1.0, 1.0, 1.0) : Colour(0.0, 0.0, 0.0);
+    };
+}
+
+TEST(AntialiasingTest, FlatImageOnlyTracesBasePass) {
+    Camera camera(20, 10, std::numbers::pi / 2.0);
+    AdaptiveAntialiaser antialiaser(camera, std::make_shared<SobolSampler>());
+    Canvas canvas(20, 10);
+    
+    auto traced = antialiaser.render(canvas, [](const Ray&) { return Colour(0.2, 0.4, 0.6); });
+    EXPECT_EQ(traced, 200);
+    EXPECT_EQ(canvas.pixelAt(7, 3), Colour(0.2, 0.4, 0.6));
+}
+
+TEST(AntialiasingTest, OnlyEdgePixelsRefined) {
+    Camera camera(20, 10, std::numbers::pi / 2.0);
+    AdaptiveAntialiaser::Settings settings;
+    settings.filter = AdaptiveAntialiaser::Filter::Box;
+    settings.maxSamples = 16;
+    settings.batchSize = 15;
+    AdaptiveAntialiaser antialiaser(camera, std::make_shared<StratifiedSampler>(15), settings);
+    Canvas canvas(20, 10);
+    
+    auto traced = antialiaser.render(canvas, edgeTrace(camera));
+    
+    for (unsigned int y = 0; y < 10; y++) {
+        EXPECT_FALSE(antialiaser.needsRefinement(8, y));
+        EXPECT_TRUE(antialiaser.needsRefinement(9, y));
+        EXPECT_TRUE(antialiaser.needsRefinement(10, y));
+        EXPECT_FALSE(antialiaser.needsRefinement(11, y));
+        
+        EXPECT_EQ(canvas.pixelAt(8, y), Colour(1.0, 1.0, 1.0));
+        EXPECT_NEAR(canvas.pixelAt(9, y).red(), 0.75, 0.1);
+        EXPECT_EQ(canvas.pixelAt(10, y), Colour(0.0, 0.0, 0.0));
+    }
+    
+    //a single batch covers every stratum, which is enough for both refined columns
+    EXPECT_EQ(traced, 200 + 20 * 15);
+}
+
+TEST(AntialiasingTest, PassesSplitByRows) {
+    Camera camera(20, 10, std::numbers::pi / 2.0);
+    auto sampler = std::make_shared<SobolSampler>();
+    auto trace = edgeTrace(camera);
+    
+    AdaptiveAntialiaser whole(camera, sampler);
+    Canvas expected(20, 10);
+    whole.render(expected, trace);
+    
+    AdaptiveAntialiaser split(camera, sampler);
+    Canvas canvas(20, 10);
+    split.basePass(canvas, trace, 5, 10);
+    split.basePass(canvas, trace, 0, 5);
+    split.refinePass(canvas, trace, 0, 3);
+    split.refinePass(canvas, trace, 3, 10);
+    
+    for (unsigned int y = 0; y < 10; y++) {
+        for (unsigned int x = 0; x < 20; x++) {
+            EXPECT_EQ(canvas.pixelAt(x, y), expected.pixelAt(x, y));
+        }
+    }
+}
+
+}
@@ -0,0 +1,133 @@
+//
+//  area_light_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "area_light.hpp"
+#include "sphere.hpp"
+#include "world.hpp"
+
+#include <cmath>
+#include <set>
+
+using namespace rtlib;
+
+namespace {
+
+//counts the shadow rays the world asks for
+class CountingLight : public RectangleLight {
+public:
+    mutable unsigned int requests = 0;
+    
+    CountingLight() :
+        RectangleLight(create_point(-1.0, 10.0, -1.0), create_vector(2.0, 0.0, 0.0), create_vector(0.0, 0.0, 2.0), Colour(1.0, 1.0, 1.0), 16, 4)
+    {
+    }
+    
+    virtual Tuple samplePoint(unsigned int index, const Tuple& from) const {
+        requests++;
+        return RectangleLight::samplePoint(index, from);
+    }
+};
+
+//a square light above a unit sphere at the origin
+std::unique_ptr<World> occluderWorld() {
+    auto world = std::make_unique<World>();
+    world->addLight(std::make_unique<CountingLight>());
+    world->addObject(std::make_unique<Sphere>());
+    return world;
+}
+
+TEST(AreaLightTest, PointLightSamplesItsOrigin) {
+    Light light(create_point(1.0, 2.0, 3.0), Colour(1.0, 1.0, 1.0));
+    EXPECT_EQ(light.sampleCount(), 1);
+    EXPECT_EQ(light.initialSamples(), 1);
+    EXPECT_EQ(light.samplePoint(0, create_point(0.0, 0.0, 0.0)), create_point(1.0, 2.0, 3.0));
+}
+
+TEST(AreaLightTest, RectangleSamplesStratifiedOverSurface) {
+    RectangleLight light(create_point(-1.0, 5.0, -2.0), create_vector(2.0, 0.0, 0.0), create_vector(0.0, 0.0, 4.0), Colour(1.0, 1.0, 1.0), 8, 4);
+    EXPECT_EQ(light.origin(), create_point(0.0, 5.0, 0.0));
+    EXPECT_EQ(light.sampleCount(), 8);
+    EXPECT_EQ(light.initialSamples(), 4);
+    
+    auto from = create_point(0.3, 0.0, 0.7);
+    std::set<unsigned int> initialStrata, laterStrata;
+    for (unsigned int i = 0; i < 8; i++) {
+        auto point = light.samplePoint(i, from);
+        EXPECT_EQ(point, light.samplePoint(i, from));
+        EXPECT_EQ(point.y(), 5.0);
+        EXPECT_GE(point.x(), -1.0);
+        EXPECT_LT(point.x(), 1.0);
+        EXPECT_GE(point.z(), -2.0);
+        EXPECT_LT(point.z(), 2.0);
+        
+        //the first batch and the rest each cover their own strata along u
+        auto& strata = i < 4 ? initialStrata : laterStrata;
+        strata.insert(static_cast<unsigned int>((point.x() + 1.0) / 2.0 * 4.0));
+    }
+    
+    EXPECT_EQ(initialStrata.size(), 4);
+    EXPECT_EQ(laterStrata.size(), 4);
+}
+
+TEST(AreaLightTest, SphereSamplesFaceThePoint) {
+    SphereLight light(create_point(0.0, 4.0, 0.0), 0.5, Colour(1.0, 1.0, 1.0));
+    auto from = create_point(3.0, 0.0, 0.0);
+    auto axis = (from - light.origin()).normalised();
+    
+    for (unsigned int i = 0; i < light.sampleCount(); i++) {
+        auto offset = light.samplePoint(i, from) - light.origin();
+        EXPECT_NEAR(Tuple::dot(offset, axis), 0.0, 1e-9);
+        EXPECT_LE(offset.magnitude(), 0.5);
+    }
+}
+
+TEST(AreaLightTest, InvalidSampleCounts) {
+    EXPECT_THROW(SphereLight(create_point(0.0, 0.0, 0.0), 1.0, Colour(1.0, 1.0, 1.0), 0, 0), std::invalid_argument);
+    EXPECT_THROW(SphereLight(create_point(0.0, 0.0, 0.0), 1.0, Colour(1.0, 1.0, 1.0), 4, 0), std::invalid_argument);
+}
+
+TEST(AreaLightTest, FullyLitUsesInitialSamplesOnly) {
+    auto world = occluderWorld();
+    const auto& light = static_cast<const CountingLight&>(*world->lights().front());
+    
+    EXPECT_EQ(world->lightVisibility(light, create_point(5.0, 0.0, 0.0)), 1.0);
+    EXPECT_EQ(light.requests, 4);
+}
+
+TEST(AreaLightTest, UmbraUsesInitialSamplesOnly) {
+    auto world = occluderWorld();
+    const auto& light = static_cast<const CountingLight&>(*world->lights().front());
+    
+    EXPECT_EQ(world->lightVisibility(light, create_point(0.0, -3.0, 0.0)), 0.0);
+    EXPECT_EQ(light.requests, 4);
+}
+
+TEST(AreaLightTest, PenumbraUsesAllSamples) {
+    auto world = occluderWorld();
+    const auto& light = static_cast<const CountingLight&>(*world->lights().front());
+    
+    auto visibility = world->lightVisibility(light, create_point(1.3, -3.0, 0.0));
+    EXPECT_GT(visibility, 0.0);
+    EXPECT_LT(visibility, 1.0);
+    EXPECT_EQ(light.requests, 16);
+}
+
+TEST(AreaLightTest, PartialVisibilityScalesDiffuseAndSpecular) {
+    Light light(create_point(0.0, 0.0, -10.0), Colour(1.0, 1.0, 1.0));
+    auto point = create_point(0.0, 0.0, 0.0);
+    auto eye = create_vector(0.0, 0.0, -1.0);
+    auto normal = create_vector(0.0, 0.0, -1.0);
+    
+    //ambient 0.1, diffuse 0.9 and specular 0.9 from the default material
+    auto half = light.lightPoint(Material(), Colour(1.0, 1.0, 1.0), point, eye, normal, 0.5);
+    EXPECT_EQ(half, Colour(1.0, 1.0, 1.0));
+    EXPECT_EQ(light.lightPoint(Material(), Colour(1.0, 1.0, 1.0), point, eye, normal, 0.0), Colour(0.1, 0.1, 0.1));
+}
+
+}
@@ -0,0 +1,106 @@
+//
+//  bounding_box_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "bounding_box.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+TEST(BoundingBoxTest, DefaultBoxIsEmpty) {
+    BoundingBox box;
+    EXPECT_TRUE(box.empty());
+    EXPECT_EQ(box.surfaceArea(), 0.0);
+}
+
+TEST(BoundingBoxTest, AddPointsGrowsBox) {
+    BoundingBox box;
+    box.addPoint(create_point(-5.0, 2.0, 0.0));
+    box.addPoint(create_point(7.0, 0.0, -3.0));
+    
+    EXPECT_FALSE(box.empty());
+    EXPECT_EQ(box.min(), create_point(-5.0, 0.0, -3.0));
+    EXPECT_EQ(box.max(), create_point(7.0, 2.0, 0.0));
+}
+
+TEST(BoundingBoxTest, AddBoxToBox) {
+    BoundingBox box(create_point(-5.0, -2.0, 0.0), create_point(7.0, 4.0, 4.0));
+    box.addBox(BoundingBox(create_point(8.0, -7.0, -2.0), create_point(14.0, 2.0, 8.0)));
+    
+    EXPECT_EQ(box.min(), create_point(-5.0, -7.0, -2.0));
+    EXPECT_EQ(box.max(), create_point(14.0, 4.0, 8.0));
+}
+
+TEST(BoundingBoxTest, SurfaceAreaAndCentroid) {
+    BoundingBox box(create_point(0.0, 0.0, 0.0), create_point(1.0, 2.0, 3.0));
+    EXPECT_EQ(box.surfaceArea(), 22.0);
+    EXPECT_EQ(box.centroid(), create_point(0.5, 1.0, 1.5));
+}
+
+TEST(BoundingBoxTest, ContainsPoint) {
+    BoundingBox box(create_point(5.0, -2.0, 0.0), create_point(11.0, 4.0, 7.0));
+    EXPECT_TRUE(box.contains(create_point(5.0, -2.0, 0.0)));
+    EXPECT_TRUE(box.contains(create_point(8.0, 1.0, 3.0)));
+    EXPECT_FALSE(box.contains(create_point(3.0, 0.0, 3.0)));
+    EXPECT_FALSE(box.contains(create_point(8.0, -4.0, 3.0)));
+    EXPECT_FALSE(box.contains(create_point(8.0, 1.0, 8.0)));
+}
+
+TEST(BoundingBoxTest, TransformBox) {
+    BoundingBox box(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0));
+    auto transformed = box.transform(rotation_x(std::numbers::pi / 4.0) * rotation_y(std::numbers::pi / 4.0));
+    
+    EXPECT_EQ(transformed.min(), create_point(-1.41421, -1.70710, -1.70710));
+    EXPECT_EQ(transformed.max(), create_point(1.41421, 1.70710, 1.70710));
+}
+
+TEST(BoundingBoxTest, TransformInfiniteBoxStaysInfinite) {
+    auto transformed = BoundingBox::infinite().transform(translation(1.0, 2.0, 3.0));
+    EXPECT_FALSE(transformed.finite());
+    EXPECT_FALSE(transformed.empty());
+}
+
+TEST(BoundingBoxTest, RayIntersectsBox) {
+    BoundingBox box(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0));
+    
+    EXPECT_TRUE(box.intersects(Ray(create_point(5.0, 0.5, 0.0), create_vector(-1.0, 0.0, 0.0))));
+    EXPECT_TRUE(box.intersects(Ray(create_point(0.5, 0.0, 0.0), create_vector(0.0, 0.0, 1.0))));
+    EXPECT_FALSE(box.intersects(Ray(create_point(-2.0, 0.0, 0.0), create_vector(2.0, 4.0, 6.0))));
+    EXPECT_FALSE(box.intersects(Ray(create_point(2.0, 2.0, 0.0), create_vector(-1.0, 0.0, 0.0))));
+    EXPECT_FALSE(box.intersects(Ray(create_point(0.0, 0.0, 5.0), create_vector(0.0, 0.0, 1.0))));
+}
+
+TEST(BoundingBoxTest, RayBoxTestRespectsMaxDistance) {
+    BoundingBox box(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0));
+    RayBoxTest test(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0)));
+    
+    EXPECT_TRUE(test.intersects(box, 10.0));
+    EXPECT_FALSE(test.intersects(box, 3.0));
+}
+
+TEST(BoundingBoxTest, SphereBoundsFollowTransform) {
+    Sphere s;
+    s.setTransform(translation(1.0, -3.0, 5.0) * scaling(0.5, 2.0, 4.0));
+    
+    auto bounds = s.bounds();
+    EXPECT_EQ(bounds.min(), create_point(0.5, -5.0, 1.0));
+    EXPECT_EQ(bounds.max(), create_point(1.5, -1.0, 9.0));
+}
+
+TEST(BoundingBoxTest, PlaneIsUnbounded) {
+    Plane p;
+    EXPECT_FALSE(p.bounds().finite());
+}
+
+}
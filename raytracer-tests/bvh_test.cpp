@@ -0,0 +1,280 @@
+//
+//  bvh_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "bvh.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+using namespace rtlib;
+
+namespace {
+
+BoundingBox unitBoxAt(double x, double y, double z) {
+    return BoundingBox(create_point(x - 0.5, y - 0.5, z - 0.5), create_point(x + 0.5, y + 0.5, z + 0.5));
+}
+
+std::vector<BoundingBox> gridOfBoxes(unsigned int size) {
+    std::vector<BoundingBox> boxes;
+    for (unsigned int x = 0; x < size; x++) {
+        for (unsigned int y = 0; y < size; y++) {
+            for (unsigned int z = 0; z < size; z++) {
+                boxes.push_back(unitBoxAt(x * 3.0, y * 3.0, z * 3.0));
+            }
+        }
+    }
+    return boxes;
+}
+
+std::vector<BoundingBox> scattered(const std::vector<BoundingBox>& boxes) {
+    //a fixed stride coprime with the count shuffles deterministically
+    std::vector<BoundingBox> result;
+    for (unsigned int i = 0; i < boxes.size(); i++) {
+        result.push_back(boxes[(i * 37) % boxes.size()]);
+    }
+    return result;
+}
+
+std::set<unsigned int> visited(const BVH& bvh, const Ray& ray) {
+    std::set<unsigned int> result;
+    bvh.traverse(ray, std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        result.insert(primitive);
+    });
+    return result;
+}
+
+void expectValidTree(const BVH& bvh, unsigned int node) {
+    const auto& n = bvh.nodes()[node];
+    if (n.leaf) {
+        EXPECT_LE(n.count, bvh.maxLeafSize());
+        for (unsigned int i = n.first; i < n.first + n.count; i++) {
+            EXPECT_TRUE(n.bounds.contains(bvh.primitiveBounds(bvh.primitives()[i])));
+        }
+        return;
+    }
+    
+    const auto& left = bvh.nodes()[n.left];
+    const auto& right = bvh.nodes()[n.right];
+    EXPECT_EQ(left.parent, node);
+    EXPECT_EQ(right.parent, node);
+    EXPECT_EQ(left.first, n.first);
+    EXPECT_EQ(left.count + right.count, n.count);
+    EXPECT_TRUE(n.bounds.contains(left.bounds));
+    EXPECT_TRUE(n.bounds.contains(right.bounds));
+    expectValidTree(bvh, n.left);
+    expectValidTree(bvh, n.right);
+}
+
+TEST(BVHTest, EmptyHierarchy) {
+    BVH bvh({});
+    EXPECT_EQ(bvh.root(), BVH::noNode);
+    EXPECT_TRUE(visited(bvh, Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 0.0, 1.0))).empty());
+}
+
+TEST(BVHTest, BuildCoversEveryPrimitiveOnce) {
+    BVH bvh(gridOfBoxes(4));
+    
+    auto primitives = bvh.primitives();
+    std::sort(primitives.begin(), primitives.end());
+    EXPECT_EQ(primitives.size(), 64);
+    for (unsigned int i = 0; i < primitives.size(); i++) {
+        EXPECT_EQ(primitives[i], i);
+    }
+    
+    expectValidTree(bvh, bvh.root());
+}
+
+TEST(BVHTest, TraversalOnlyVisitsPrimitivesAlongRay) {
+    auto boxes = gridOfBoxes(4);
+    BVH bvh(boxes);
+    Ray ray(create_point(3.0, 6.0, -10.0), create_vector(0.0, 0.0, 1.0));
+    
+    std::set<unsigned int> expected;
+    for (unsigned int i = 0; i < boxes.size(); i++) {
+        if (boxes[i].intersects(ray)) {
+            expected.insert(i);
+        }
+    }
+    
+    auto result = visited(bvh, ray);
+    EXPECT_EQ(expected.size(), 4);
+    for (auto primitive : expected) {
+        EXPECT_TRUE(result.count(primitive));
+    }
+    EXPECT_LT(result.size(), boxes.size() / 2);
+}
+
+TEST(BVHTest, RefitGrowsAncestorsOfMovedPrimitive) {
+    BVH bvh(gridOfBoxes(3));
+    bvh.setPrimitiveBounds(5, unitBoxAt(20.0, 20.0, 20.0));
+    bvh.refit({5});
+    
+    expectValidTree(bvh, bvh.root());
+    auto result = visited(bvh, Ray(create_point(20.0, 20.0, -10.0), create_vector(0.0, 0.0, 1.0)));
+    EXPECT_EQ(result, std::set<unsigned int>({5}));
+}
+
+TEST(BVHTest, SmallMovesDoNotTriggerRebuild) {
+    BVH bvh(gridOfBoxes(3));
+    auto nodeCount = bvh.nodes().size();
+    
+    bvh.setPrimitiveBounds(5, unitBoxAt(0.1, 3.1, 6.1));
+    bvh.refit({5});
+    
+    EXPECT_EQ(bvh.rebuildDegraded(1.5), 0);
+    EXPECT_EQ(bvh.nodes().size(), nodeCount);
+}
+
+TEST(BVHTest, DegradedHierarchyIsRebuilt) {
+    auto boxes = gridOfBoxes(4);
+    BVH bvh(boxes);
+    
+    //scatter every primitive across the grid so each refit leaf spans most of it
+    boxes = scattered(boxes);
+    std::vector<unsigned int> moved;
+    for (unsigned int i = 0; i < boxes.size(); i++) {
+        bvh.setPrimitiveBounds(i, boxes[i]);
+        moved.push_back(i);
+    }
+    bvh.refit(moved);
+    auto refitCost = bvh.cost();
+    EXPECT_GT(refitCost, BVH(boxes).cost());
+    
+    EXPECT_GT(bvh.rebuildDegraded(1.5), 0);
+    EXPECT_LT(bvh.cost(), refitCost);
+    expectValidTree(bvh, bvh.root());
+    
+    for (unsigned int i = 0; i < boxes.size(); i++) {
+        auto centre = boxes[i].centroid();
+        auto result = visited(bvh, Ray(create_point(centre.x(), centre.y(), -100.0), create_vector(0.0, 0.0, 1.0)));
+        EXPECT_TRUE(result.count(i));
+    }
+}
+
+TEST(BVHTest, DegradedSubtreeIsRebuiltInPlace) {
+    auto boxes = gridOfBoxes(4);
+    BVH bvh(boxes);
+    const auto& root = bvh.nodes()[bvh.root()];
+    const auto& left = bvh.nodes()[root.left];
+    
+    //shuffle only the primitives under the left child, the rest of the tree stays put
+    std::vector<unsigned int> moved(bvh.primitives().begin() + left.first,
+                                    bvh.primitives().begin() + left.first + left.count);
+    std::vector<BoundingBox> shuffled;
+    for (auto primitive : moved) {
+        shuffled.push_back(boxes[primitive]);
+    }
+    shuffled = scattered(shuffled);
+    for (unsigned int i = 0; i < moved.size(); i++) {
+        boxes[moved[i]] = shuffled[i];
+        bvh.setPrimitiveBounds(moved[i], shuffled[i]);
+    }
+    
+    auto rootBounds = root.bounds;
+    bvh.refit(moved);
+    EXPECT_EQ(bvh.nodes()[bvh.root()].bounds, rootBounds);
+    
+    EXPECT_EQ(bvh.rebuildDegraded(1.5), 1);
+    expectValidTree(bvh, bvh.root());
+    EXPECT_LE(bvh.liveNodeCount(), bvh.nodes().size());
+    
+    for (unsigned int i = 0; i < boxes.size(); i++) {
+        auto centre = boxes[i].centroid();
+        auto result = visited(bvh, Ray(create_point(centre.x(), centre.y(), -100.0), create_vector(0.0, 0.0, 1.0)));
+        EXPECT_TRUE(result.count(i));
+    }
+}
+
+TEST(BVHTest, VisitorCanEndTraversal) {
+    BVH bvh(scattered(gridOfBoxes(8)), 2);
+    Ray ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    
+    unsigned int primitives = 0;
+    auto allNodes = bvh.traverse(ray, std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        primitives++;
+    });
+    EXPECT_EQ(primitives, 8);
+    
+    //an any-hit query done with the first primitive skips the rest of the tree
+    primitives = 0;
+    auto someNodes = bvh.traverse(ray, std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        primitives++;
+        return true;
+    });
+    EXPECT_EQ(primitives, 1);
+    EXPECT_LT(someNodes, allNodes);
+    
+    unsigned int leaves = 0;
+    bvh.traverseLeaves(ray, std::numeric_limits<double>::infinity(), [&](unsigned int first, unsigned int count) {
+        leaves++;
+        return true;
+    });
+    EXPECT_EQ(leaves, 1);
+}
+
+TEST(BVHTest, WorldIntersectionsMatchWithHierarchy) {
+    auto w = World::defaultWorld();
+    for (unsigned int i = 0; i < 10; i++) {
+        auto s = std::make_unique<Sphere>();
+        s->setTransform(translation(i * 1.5 - 7.0, 0.5, 3.0) * scaling(0.5, 0.5, 0.5));
+        w->addObject(std::move(s));
+    }
+    
+    Ray r(create_point(-7.0, 0.5, -5.0), create_vector(0.0, 0.0, 1.0));
+    auto expected = w->intersects(r);
+    
+    w->buildBVH();
+    auto hits = w->intersects(r);
+    EXPECT_EQ(hits.size(), expected.size());
+    for (unsigned int i = 0; i < hits.size(); i++) {
+        EXPECT_EQ(hits[i], expected[i]);
+    }
+}
+
+TEST(BVHTest, WorldUpdatePicksUpMovedObjects) {
+    auto w = World::defaultWorld();
+    w->buildBVH();
+    
+    Ray r(create_point(5.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    EXPECT_TRUE(w->intersects(r).empty());
+    
+    w->objects().front()->setTransform(translation(5.0, 0.0, 0.0));
+    w->updateBVH();
+    
+    auto hits = w->intersects(r);
+    EXPECT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits.front().object, w->objects().front().get());
+}
+
+TEST(BVHTest, WorldQueriesThrowWhenBoundsAreStale) {
+    auto w = World::defaultWorld();
+    w->buildBVH();
+    
+    //objects outside the world moving doesn't make its tree stale
+    Sphere elsewhere;
+    elsewhere.setTransform(translation(1.0, 0.0, 0.0));
+    Ray r(create_point(5.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    EXPECT_TRUE(w->intersects(r).empty());
+    
+    w->objects().front()->setTransform(translation(5.0, 0.0, 0.0));
+    EXPECT_THROW(w->intersects(r), std::logic_error);
+    EXPECT_THROW(w->isOccluded(create_point(5.0, 0.0, -5.0), create_point(5.0, 0.0, 5.0)), std::logic_error);
+    
+    w->updateBVH();
+    EXPECT_EQ(w->intersects(r).size(), 2);
+    
+    w->objects().push_back(std::make_unique<Sphere>());
+    EXPECT_THROW(w->intersects(r), std::logic_error);
+}
+
+}
@@ -10,8 +10,10 @@
 #include "camera.hpp"
 #include "transformations.hpp"
 
+#include <array>
 #include <cmath>
 #include <numbers>
+#include <stdexcept>
 
 namespace {
 
@@ -58,5 +60,125 @@ TEST(CameraTest, RayOnTransformedCamera) {
     EXPECT_EQ(ray.direction(), rtlib::create_vector(std::sqrt(2.0) / 2.0, 0.0, -std::sqrt(2.0) / 2.0));
 }
 
+TEST(CameraTest, PixelForPointReversesRay) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    camera.setTransform(rtlib::rotation_y(std::numbers::pi / 4.0) * rtlib::translation(0.0, -2.0, 5.0));
+    
+    auto ray = camera.rayForPixel(37, 80, 0.3, 0.6);
+    auto pixel = camera.pixelForPoint(ray.positionAt(7.0));
+    ASSERT_TRUE(pixel);
+    EXPECT_EQ((*pixel)[0], 37);
+    EXPECT_EQ((*pixel)[1], 80);
+    
+    EXPECT_FALSE(camera.pixelForPoint(ray.positionAt(-1.0)));
+}
+
+TEST(CameraTest, TileRaysMatchRayForPixel) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    camera.setTransform(rtlib::rotation_y(std::numbers::pi / 4.0) * rtlib::translation(0.0, -2.0, 5.0));
+    
+    rtlib::Camera::TileRays rays;
+    camera.raysForTile(90, 40, 122, 56, 0.25, 0.75, rays);
+    ASSERT_EQ(rays.size(), 32 * 16);
+    
+    unsigned int index = 0;
+    for (unsigned int y = 40; y < 56; y++) {
+        for (unsigned int x = 90; x < 122; x++, index++) {
+            auto expected = camera.rayForPixel(x, y, 0.25, 0.75);
+            auto ray = rays.ray(index);
+            EXPECT_EQ(ray.origin(), expected.origin());
+            EXPECT_EQ(ray.direction(), expected.direction());
+        }
+    }
+}
+
+TEST(CameraTest, TileRaysFollowNewTransform) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    rtlib::Camera::TileRays rays;
+    camera.raysForTile(100, 50, 101, 51, rays);
+    EXPECT_EQ(rays.ray(0).direction(), rtlib::create_vector(0.0, 0.0, -1.0));
+    
+    camera.setTransform(rtlib::rotation_y(std::numbers::pi / 4.0) * rtlib::translation(0.0, -2.0, 5.0));
+    camera.raysForTile(100, 50, 101, 51, rays);
+    EXPECT_EQ(rays.ray(0).origin(), rtlib::create_point(0.0, 2.0, -5.0));
+    EXPECT_EQ(rays.ray(0).direction(), rtlib::create_vector(std::sqrt(2.0) / 2.0, 0.0, -std::sqrt(2.0) / 2.0));
+}
+
+TEST(CameraTest, TileFrustumHoldsTileRays) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    camera.setTransform(rtlib::rotation_y(std::numbers::pi / 4.0) * rtlib::translation(0.0, -2.0, 5.0));
+    auto frustum = camera.tileFrustum(90, 40, 122, 56);
+    ASSERT_EQ(frustum.planes.size(), 4);
+    
+    auto pointBox = [](const rtlib::Tuple& point) {
+        rtlib::BoundingBox box;
+        box.addPoint(point);
+        return box;
+    };
+    
+    for (auto offset : {std::array<double, 2>{0.0, 0.0}, {0.5, 0.5}, {0.999, 0.999}}) {
+        EXPECT_TRUE(frustum.intersects(pointBox(camera.rayForPixel(90, 40, offset[0], offset[1]).positionAt(10.0))));
+        EXPECT_TRUE(frustum.intersects(pointBox(camera.rayForPixel(121, 55, offset[0], offset[1]).positionAt(10.0))));
+    }
+    
+    EXPECT_FALSE(frustum.intersects(pointBox(camera.rayForPixel(10, 40).positionAt(10.0))));
+    EXPECT_FALSE(frustum.intersects(pointBox(camera.rayForPixel(100, 90).positionAt(10.0))));
+    EXPECT_FALSE(frustum.intersects(pointBox(camera.rayForPixel(100, 50).positionAt(-10.0))));
+}
+
+TEST(CameraTest, PinholeByDefault) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    EXPECT_TRUE(camera.isPinhole());
+    EXPECT_EQ(camera.apertureRadius(), 0.0);
+    
+    auto ray = camera.rayForPixel(0, 0, 0.5, 0.5, 0.9, 0.1);
+    EXPECT_EQ(ray.origin(), rtlib::create_point(0.0, 0.0, 0.0));
+    EXPECT_EQ(ray.direction(), camera.rayForPixel(0, 0).direction());
+    EXPECT_THROW(camera.setLens(-1.0, 5.0), std::invalid_argument);
+}
+
+TEST(CameraTest, LensRaysMeetAtFocalDistance) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    camera.setTransform(rtlib::rotation_y(std::numbers::pi / 4.0) * rtlib::translation(0.0, -2.0, 5.0));
+    camera.setLens(0.2, 4.0);
+    EXPECT_FALSE(camera.isPinhole());
+    
+    auto pinhole = camera.rayForPixel(30, 70, 0.25, 0.75);
+    auto focus = pinhole.positionAt(4.0 / -(camera.transform() * pinhole.direction()).z());
+    for (auto lens : {std::array<double, 2>{0.0, 0.0}, {0.99, 0.5}, {0.2, 0.9}, {0.5, 0.5}}) {
+        auto ray = camera.rayForPixel(30, 70, 0.25, 0.75, lens[0], lens[1]);
+        
+        //origins stay on the aperture, directions pass through the pinhole ray's focus point
+        auto local = camera.transform() * ray.origin();
+        EXPECT_NEAR(local.z(), 0.0, 1e-9);
+        EXPECT_LE(std::sqrt(local.x() * local.x() + local.y() * local.y()), 0.2 + 1e-9);
+        
+        auto reached = ray.positionAt((focus - ray.origin()).magnitude());
+        EXPECT_EQ(reached, focus);
+    }
+    
+    EXPECT_EQ(camera.rayForPixel(30, 70, 0.25, 0.75, 0.5, 0.5).origin(), pinhole.origin());
+}
+
+TEST(CameraTest, CircleOfConfusion) {
+    rtlib::Camera camera(200, 125, std::numbers::pi / 2.0);
+    camera.setLens(0.1, 5.0);
+    
+    EXPECT_NEAR(camera.circleOfConfusion(rtlib::create_point(1.0, 0.0, -5.0)), 0.0, 1e-9);
+    EXPECT_DOUBLE_EQ(camera.circleOfConfusion(rtlib::create_point(0.0, 0.0, -2.0)), 2.0 * 0.1 * (1.0 / 2.0 - 1.0 / 5.0) / 0.01);
+    EXPECT_GT(camera.circleOfConfusion(rtlib::create_point(0.0, 0.0, -100.0)), 0.0);
+}
+
+TEST(CameraTest, ShutterSetsRayTimes) {
+    rtlib::Camera camera(201, 101, std::numbers::pi / 2.0);
+    EXPECT_FALSE(camera.hasMotionBlur());
+    EXPECT_EQ(camera.rayForPixel(3, 4).time(), 0.0);
+    
+    camera.setShutter(0.25, 0.75);
+    EXPECT_TRUE(camera.hasMotionBlur());
+    EXPECT_EQ(camera.rayForPixel(3, 4).time(), 0.25);
+    EXPECT_DOUBLE_EQ(camera.shutterTime(0.5), 0.5);
+    EXPECT_THROW(camera.setShutter(0.5, 0.25), std::invalid_argument);
+}
 
 }
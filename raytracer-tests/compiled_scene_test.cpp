@@ -0,0 +1,201 @@
+//
+//  compiled_scene_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "TestPattern.hpp"
+
+#include "camera.hpp"
+#include "compiled_scene.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+class OffsetSphere : public Sphere {
+};
+
+std::unique_ptr<World> patternedWorld() {
+    auto w = World::defaultWorld();
+    
+    auto floor = std::make_unique<Plane>();
+    floor->setTransform(translation(0.0, -1.0, 0.0));
+    floor->material()._pattern = std::make_shared<CheckersPattern>(Colour(1.0, 1.0, 1.0), Colour(0.0, 0.0, 0.0));
+    floor->material()._reflective = 0.3;
+    w->addObject(std::move(floor));
+    
+    auto striped = std::make_unique<Sphere>();
+    striped->setTransform(translation(1.5, 0.0, 1.0) * scaling(0.5, 0.5, 0.5));
+    striped->material()._pattern = std::make_shared<StripePattern>(Colour(1.0, 0.0, 0.0), Colour(0.0, 0.0, 1.0));
+    striped->material()._pattern->setTransform(scaling(0.2, 0.2, 0.2));
+    w->addObject(std::move(striped));
+    
+    auto custom = std::make_unique<OffsetSphere>();
+    custom->setTransform(translation(-1.5, 0.0, 1.0) * scaling(0.5, 0.5, 0.5));
+    custom->material()._pattern = std::make_shared<rtlib_tests::TestPattern>();
+    w->addObject(std::move(custom));
+    
+    return w;
+}
+
+TEST(CompiledSceneTest, GroupsObjectsByExactType) {
+    auto w = patternedWorld();
+    CompiledScene scene(w->objects());
+    
+    EXPECT_EQ(scene.size(), 5);
+    EXPECT_EQ(scene.shapeKind(0), CompiledScene::ShapeKind::Sphere);
+    EXPECT_EQ(scene.shapeKind(2), CompiledScene::ShapeKind::Plane);
+    EXPECT_EQ(scene.shapeKind(3), CompiledScene::ShapeKind::Sphere);
+    EXPECT_EQ(scene.shapeKind(4), CompiledScene::ShapeKind::Other);
+}
+
+TEST(CompiledSceneTest, IntersectionsMatchVirtualDispatch) {
+    auto w = patternedWorld();
+    CompiledScene scene(w->objects());
+    
+    for (unsigned int i = 0; i < 20; i++) {
+        Ray r(create_point(-2.0 + i * 0.2, 0.1, -5.0), create_vector(0.0, -0.1, 1.0).normalised());
+        
+        for (unsigned int o = 0; o < scene.size(); o++) {
+            Intersections hits;
+            scene.intersects(o, r, hits);
+            auto expected = w->objects()[o]->intersects(r);
+            
+            ASSERT_EQ(hits.size(), expected.size());
+            for (unsigned int h = 0; h < hits.size(); h++) {
+                EXPECT_EQ(hits[h], expected[h]);
+            }
+        }
+    }
+}
+
+TEST(CompiledSceneTest, NormalsAndColoursMatchVirtualDispatch) {
+    auto w = patternedWorld();
+    CompiledScene scene(w->objects());
+    
+    for (unsigned int o = 0; o < scene.size(); o++) {
+        const auto* object = w->objects()[o].get();
+        for (unsigned int i = 0; i < 10; i++) {
+            auto direction = create_vector(std::cos(i * 0.6), std::sin(i * 0.6), 0.3).normalised();
+            auto local = create_point(direction.x(), direction.y(), direction.z());
+            auto point = object->transform() * local;
+            Intersect hit(object, 1.0);
+            hit.entry = o;
+            
+            EXPECT_EQ(scene.normalAt(hit, point), object->normalAt(point));
+            EXPECT_EQ(scene.colourAt(hit, point), object->material().colourAt(object, point));
+        }
+    }
+}
+
+TEST(CompiledSceneTest, UpdatePicksUpMovedObjects) {
+    auto w = World::defaultWorld();
+    CompiledScene scene(w->objects());
+    
+    w->objects().front()->setTransform(translation(0.0, 5.0, 0.0));
+    scene.update();
+    
+    Intersections hits;
+    scene.intersects(0, Ray(create_point(0.0, 5.0, -5.0), create_vector(0.0, 0.0, 1.0)), hits);
+    EXPECT_EQ(hits.size(), 2);
+}
+
+TEST(CompiledSceneTest, HitsCarryTheirEntry) {
+    auto w = patternedWorld();
+    CompiledScene scene(w->objects());
+    
+    auto hits = scene.intersects(Ray(create_point(1.5, 0.0, -5.0), create_vector(0.0, 0.0, 1.0)));
+    ASSERT_FALSE(hits.empty());
+    for (const auto& hit : hits) {
+        ASSERT_NE(hit.entry, Intersect::noEntry);
+        EXPECT_EQ(hit.object, w->objects()[hit.entry].get());
+    }
+}
+
+TEST(CompiledSceneTest, MaterialEditsShadeWithNewValues) {
+    auto w = patternedWorld();
+    CompiledScene scene(w->objects());
+    
+    Intersections hits;
+    scene.intersects(3, Ray(create_point(1.5, 0.0, -5.0), create_vector(0.0, 0.0, 1.0)), hits);
+    ASSERT_EQ(hits.size(), 2);
+    const auto* striped = w->objects()[3].get();
+    auto point = create_point(1.8, 0.0, 0.6);
+    auto before = scene.colourAt(hits.front(), point);
+    
+    auto expectMatches = [&]() {
+        EXPECT_EQ(scene.colourAt(hits.front(), point), striped->material().colourAt(striped, point));
+    };
+    
+    //picked up before update, then compiled in by it
+    w->objects()[3]->material()._pattern->setTransform(scaling(0.3, 0.3, 0.3));
+    EXPECT_NE(scene.colourAt(hits.front(), point), before);
+    expectMatches();
+    scene.update();
+    expectMatches();
+    
+    Material plain;
+    plain._colour = Colour(0.2, 0.4, 0.6);
+    w->objects()[3]->setMaterial(plain);
+    EXPECT_EQ(scene.colourAt(hits.front(), point), plain._colour);
+    scene.update();
+    EXPECT_EQ(scene.colourAt(hits.front(), point), plain._colour);
+}
+
+TEST(CompiledSceneTest, RenderMatchesUncompiledWorld) {
+    auto w = patternedWorld();
+    auto c = Camera(11, 11, std::numbers::pi / 2.0);
+    c.setTransform(viewTransform(create_point(0.0, 1.0, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    
+    std::vector<Colour> expected;
+    for (unsigned int y = 0; y < 11; y++) {
+        for (unsigned int x = 0; x < 11; x++) {
+            expected.push_back(w->colourAt(c.rayForPixel(x, y)));
+        }
+    }
+    
+    w->compile();
+    w->buildBVH();
+    for (unsigned int y = 0; y < 11; y++) {
+        for (unsigned int x = 0; x < 11; x++) {
+            EXPECT_EQ(w->colourAt(c.rayForPixel(x, y)), expected[y * 11 + x]);
+        }
+    }
+}
+
+TEST(CompiledSceneTest, WorldQueriesThrowWhenCompiledSceneIsStale) {
+    auto w = World::defaultWorld();
+    w->compile();
+    Ray r(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    const auto& light = *w->lights().front();
+    
+    w->objects().front()->setTransform(translation(100.0, 0.0, 0.0));
+    EXPECT_THROW(w->intersects(r), std::logic_error);
+    
+    //with no BVH yet updateBVH builds one, the compiled inverses still need bringing up to date
+    w->updateBVH();
+    auto hits = w->intersects(r);
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits[0].t, 4.5);
+    
+    w->objects().push_back(std::make_unique<Sphere>());
+    EXPECT_THROW(w->intersects(r), std::logic_error);
+    EXPECT_THROW(w->isOccluded(create_point(0.0, 0.0, -5.0), create_point(0.0, 0.0, 5.0), light), std::logic_error);
+    
+    w->updateBVH();
+    EXPECT_EQ(w->compiledScene()->size(), 3);
+    EXPECT_TRUE(w->isOccluded(create_point(0.0, 0.0, -5.0), create_point(0.0, 0.0, 5.0), light));
+    EXPECT_EQ(w->intersects(r).size(), 4);
+}
+
+}
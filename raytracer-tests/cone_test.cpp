@@ -0,0 +1,71 @@
+//
+//  cone_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "cone.hpp"
+
+#include <cmath>
+
+using namespace rtlib;
+
+namespace {
+
+TEST(ConeTest, RayStrikesCone) {
+    Cone cone;
+    const std::vector<std::tuple<Tuple, Tuple, double, double>> cases = {
+        {create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 5.0, 5.0},
+        {create_point(0.0, 0.0, -5.0), create_vector(1.0, 1.0, 1.0), 8.66025, 8.66025},
+        {create_point(1.0, 1.0, -5.0), create_vector(-0.5, -1.0, 1.0), 4.55006, 49.44994}
+    };
+    
+    for (const auto& [origin, direction, t0, t1] : cases) {
+        auto hits = cone.intersects(Ray(origin, direction.normalised()));
+        ASSERT_EQ(hits.size(), 2);
+        EXPECT_NEAR(hits[0].t, t0, 0.0001);
+        EXPECT_NEAR(hits[1].t, t1, 0.0001);
+    }
+}
+
+TEST(ConeTest, RayParallelToOneHalf) {
+    Cone cone;
+    auto hits = cone.intersects(Ray(create_point(0.0, 0.0, -1.0), create_vector(0.0, 1.0, 1.0).normalised()));
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_NEAR(hits[0].t, 0.35355, 0.0001);
+}
+
+TEST(ConeTest, IntersectingCaps) {
+    Cone cone(-0.5, 0.5, true);
+    const std::vector<std::tuple<Tuple, Tuple, unsigned int>> cases = {
+        {create_point(0.0, 0.0, -5.0), create_vector(0.0, 1.0, 0.0), 0},
+        {create_point(0.0, 0.0, -0.25), create_vector(0.0, 1.0, 1.0), 2},
+        {create_point(0.0, 0.0, -0.25), create_vector(0.0, 1.0, 0.0), 4}
+    };
+    
+    for (const auto& [origin, direction, count] : cases) {
+        EXPECT_EQ(cone.intersects(Ray(origin, direction.normalised())).size(), count);
+    }
+}
+
+TEST(ConeTest, NormalOnWall) {
+    Cone cone;
+    EXPECT_EQ(cone.normalAt(create_point(1.0, 1.0, 1.0)), create_vector(1.0, -std::sqrt(2.0), 1.0).normalised());
+    EXPECT_EQ(cone.normalAt(create_point(-1.0, -1.0, 0.0)), create_vector(-1.0, 1.0, 0.0).normalised());
+}
+
+TEST(ConeTest, NormalOnCaps) {
+    Cone cone(-1.0, 2.0, true);
+    EXPECT_EQ(cone.normalAt(create_point(0.5, 2.0, 0.0)), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(cone.normalAt(create_point(0.0, -1.0, 0.5)), create_vector(0.0, -1.0, 0.0));
+}
+
+TEST(ConeTest, BoundsCoverTheWiderEnd) {
+    Cone cone(-1.0, 2.0, true);
+    EXPECT_EQ(cone.localBounds(), BoundingBox(create_point(-2.0, -1.0, -2.0), create_point(2.0, 2.0, 2.0)));
+}
+
+}
@@ -0,0 +1,235 @@
+//
+//  csg_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "cube.hpp"
+#include "csg.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+
+#include <cmath>
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+class CountingSphere : public Sphere {
+public:
+    mutable unsigned int calls = 0;
+    
+protected:
+    virtual Intersections intersectsImpl(const Ray& ray) const {
+        calls++;
+        return Sphere::intersectsImpl(ray);
+    }
+};
+
+TEST(CSGTest, CreatedWithOperationAndChildren) {
+    auto s1 = std::make_unique<Sphere>();
+    auto s2 = std::make_unique<Cube>();
+    const Object* left = s1.get();
+    const Object* right = s2.get();
+    
+    CSG c(CSG::Operation::Union, std::move(s1), std::move(s2));
+    EXPECT_EQ(c.operation(), CSG::Operation::Union);
+    EXPECT_EQ(c.left(), left);
+    EXPECT_EQ(c.right(), right);
+    EXPECT_EQ(left->parent(), &c);
+    EXPECT_EQ(right->parent(), &c);
+}
+
+TEST(CSGTest, IntersectionAllowedRules) {
+    using Op = CSG::Operation;
+    const std::vector<std::tuple<Op, bool, bool, bool, bool>> cases = {
+        {Op::Union, true, true, true, false},
+        {Op::Union, true, true, false, true},
+        {Op::Union, true, false, true, false},
+        {Op::Union, true, false, false, true},
+        {Op::Union, false, true, true, false},
+        {Op::Union, false, true, false, false},
+        {Op::Union, false, false, true, true},
+        {Op::Union, false, false, false, true},
+        {Op::Intersection, true, true, true, true},
+        {Op::Intersection, true, true, false, false},
+        {Op::Intersection, true, false, true, true},
+        {Op::Intersection, true, false, false, false},
+        {Op::Intersection, false, true, true, true},
+        {Op::Intersection, false, true, false, true},
+        {Op::Intersection, false, false, true, false},
+        {Op::Intersection, false, false, false, false},
+        {Op::Difference, true, true, true, false},
+        {Op::Difference, true, true, false, true},
+        {Op::Difference, true, false, true, false},
+        {Op::Difference, true, false, false, true},
+        {Op::Difference, false, true, true, true},
+        {Op::Difference, false, true, false, true},
+        {Op::Difference, false, false, true, false},
+        {Op::Difference, false, false, false, false}
+    };
+    
+    for (const auto& [operation, leftHit, insideLeft, insideRight, allowed] : cases) {
+        EXPECT_EQ(CSG::intersectionAllowed(operation, leftHit, insideLeft, insideRight), allowed);
+    }
+}
+
+TEST(CSGTest, KeepsOnlyAllowedBoundaries) {
+    //two overlapping spheres along the ray give boundaries at 4, 4.5, 6 and 6.5
+    using Op = CSG::Operation;
+    const std::vector<std::tuple<Op, double, bool, double, bool>> cases = {
+        {Op::Union, 4.0, true, 6.5, false},
+        {Op::Intersection, 4.5, false, 6.0, true},
+        {Op::Difference, 4.0, true, 4.5, false}
+    };
+    
+    for (const auto& [operation, t0, leftFirst, t1, leftSecond] : cases) {
+        auto s1 = std::make_unique<Sphere>();
+        auto s2 = std::make_unique<Sphere>();
+        s2->setTransform(translation(0.0, 0.0, 0.5));
+        const Object* left = s1.get();
+        const Object* right = s2.get();
+        CSG c(operation, std::move(s1), std::move(s2));
+        
+        auto hits = c.intersects(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0)));
+        ASSERT_EQ(hits.size(), 2);
+        EXPECT_EQ(hits[0].t, t0);
+        EXPECT_EQ(hits[1].t, t1);
+        EXPECT_EQ(hits[0].object, leftFirst ? left : right);
+        EXPECT_EQ(hits[1].object, leftSecond ? left : right);
+    }
+}
+
+TEST(CSGTest, RayMissesCSG) {
+    CSG c(CSG::Operation::Union, std::make_unique<Sphere>(), std::make_unique<Cube>());
+    EXPECT_TRUE(c.intersects(Ray(create_point(0.0, 2.0, -5.0), create_vector(0.0, 0.0, 1.0))).empty());
+}
+
+TEST(CSGTest, ChildrenOutsideTheRaySkipped) {
+    auto s1 = std::make_unique<CountingSphere>();
+    auto s2 = std::make_unique<CountingSphere>();
+    s2->setTransform(translation(5.0, 0.0, 0.0));
+    auto* left = s1.get();
+    auto* right = s2.get();
+    
+    CSG difference(CSG::Operation::Difference, std::move(s1), std::move(s2));
+    auto hits = difference.intersects(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0)));
+    EXPECT_EQ(hits.size(), 2);
+    EXPECT_EQ(left->calls, 1);
+    EXPECT_EQ(right->calls, 0);
+    
+    //with the left child missed an intersection can't be hit, so neither child is tested
+    auto s3 = std::make_unique<CountingSphere>();
+    auto s4 = std::make_unique<CountingSphere>();
+    s3->setTransform(translation(5.0, 0.0, 0.0));
+    left = s3.get();
+    right = s4.get();
+    
+    CSG intersection(CSG::Operation::Intersection, std::move(s3), std::move(s4));
+    EXPECT_TRUE(intersection.intersects(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0))).empty());
+    EXPECT_EQ(left->calls, 0);
+    EXPECT_EQ(right->calls, 0);
+}
+
+TEST(CSGTest, RightChildUntestedWhenLeftHasNoBoundaries) {
+    //the ray clips the left sphere's bounds without touching the sphere
+    auto s1 = std::make_unique<CountingSphere>();
+    auto s2 = std::make_unique<CountingSphere>();
+    s2->setTransform(translation(0.9, 0.9, 0.0));
+    auto* left = s1.get();
+    auto* right = s2.get();
+    
+    CSG difference(CSG::Operation::Difference, std::move(s1), std::move(s2));
+    EXPECT_TRUE(difference.intersects(Ray(create_point(0.9, 0.9, -5.0), create_vector(0.0, 0.0, 1.0))).empty());
+    EXPECT_EQ(left->calls, 1);
+    EXPECT_EQ(right->calls, 0);
+}
+
+TEST(CSGTest, FirstHitQueryStopsAtNearestKeptBoundary) {
+    //a union nested in a union, boundaries at 4 and 6 then 14 and 16 then 24 and 26
+    auto near = std::make_unique<Sphere>();
+    auto middle = std::make_unique<Sphere>();
+    middle->setTransform(translation(0.0, 0.0, 10.0));
+    auto far = std::make_unique<Sphere>();
+    far->setTransform(translation(0.0, 0.0, 20.0));
+    
+    auto inner = std::make_unique<CSG>(CSG::Operation::Union, std::move(middle), std::move(far));
+    CSG outer(CSG::Operation::Union, std::move(near), std::move(inner));
+    
+    Ray ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    EXPECT_EQ(outer.intersects(ray).size(), 6);
+    
+    auto hits = outer.intersectsToFirstHit(ray);
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].t, 4.0);
+    
+    //from inside the near sphere its entry is behind the origin and stays in for refraction
+    hits = outer.intersectsToFirstHit(Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 0.0, 1.0)));
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits[0].t, -1.0);
+    EXPECT_EQ(hits[1].t, 1.0);
+    
+    //children wholly behind the origin are skipped, nested ones included
+    hits = outer.intersectsToFirstHit(Ray(create_point(0.0, 0.0, 12.0), create_vector(0.0, 0.0, 1.0)));
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].t, 7.0);
+}
+
+TEST(CSGTest, ChildrenMovedAfterCombiningStillHit) {
+    auto near = std::make_unique<Sphere>();
+    auto middle = std::make_unique<Sphere>();
+    auto far = std::make_unique<Sphere>();
+    auto* nearPtr = near.get();
+    auto* farPtr = far.get();
+    
+    auto inner = std::make_unique<CSG>(CSG::Operation::Union, std::move(middle), std::move(far));
+    CSG outer(CSG::Operation::Union, std::move(near), std::move(inner));
+    EXPECT_TRUE(outer.childrenUnchanged());
+    
+    //bounds taken when the csgs were made would cull both spheres off the ray
+    Ray ray(create_point(5.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    nearPtr->setTransform(translation(5.0, 0.0, 0.0));
+    farPtr->setTransform(translation(5.0, 0.0, 20.0));
+    EXPECT_FALSE(outer.childrenUnchanged());
+    
+    auto hits = outer.intersects(ray);
+    ASSERT_EQ(hits.size(), 4);
+    EXPECT_EQ(hits[0].t, 4.0);
+    EXPECT_EQ(hits[3].t, 26.0);
+}
+
+TEST(CSGTest, BoundsFollowOperation) {
+    auto makeCSG = [](CSG::Operation operation) {
+        auto s1 = std::make_unique<Sphere>();
+        auto s2 = std::make_unique<Sphere>();
+        s2->setTransform(translation(1.0, 0.0, 0.0));
+        return CSG(operation, std::move(s1), std::move(s2));
+    };
+    
+    EXPECT_EQ(makeCSG(CSG::Operation::Union).localBounds(),
+              BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(2.0, 1.0, 1.0)));
+    EXPECT_EQ(makeCSG(CSG::Operation::Intersection).localBounds(),
+              BoundingBox(create_point(0.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0)));
+    EXPECT_EQ(makeCSG(CSG::Operation::Difference).localBounds(),
+              BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0)));
+}
+
+TEST(CSGTest, ChildNormalsIncludeParentTransform) {
+    auto s = std::make_unique<Sphere>();
+    s->setTransform(translation(5.0, 0.0, 0.0));
+    const Object* child = s.get();
+    
+    CSG c(CSG::Operation::Union, std::move(s), std::make_unique<Cube>());
+    c.setTransform(rotation_y(std::numbers::pi / 2.0) * scaling(1.0, 2.0, 3.0));
+    
+    auto normal = child->normalAt(create_point(1.7321, 1.1547, -5.5774));
+    EXPECT_NEAR(normal.x(), 0.2857, 0.0001);
+    EXPECT_NEAR(normal.y(), 0.4286, 0.0001);
+    EXPECT_NEAR(normal.z(), -0.8571, 0.0001);
+}
+
+}
@@ -0,0 +1,69 @@
+//
+//  cube_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "cube.hpp"
+
+using namespace rtlib;
+
+namespace {
+
+TEST(CubeTest, RayIntersectsEachFace) {
+    Cube c;
+    const std::vector<std::tuple<Tuple, Tuple, double, double>> cases = {
+        {create_point(5.0, 0.5, 0.0), create_vector(-1.0, 0.0, 0.0), 4.0, 6.0},
+        {create_point(-5.0, 0.5, 0.0), create_vector(1.0, 0.0, 0.0), 4.0, 6.0},
+        {create_point(0.5, 5.0, 0.0), create_vector(0.0, -1.0, 0.0), 4.0, 6.0},
+        {create_point(0.5, -5.0, 0.0), create_vector(0.0, 1.0, 0.0), 4.0, 6.0},
+        {create_point(0.5, 0.0, 5.0), create_vector(0.0, 0.0, -1.0), 4.0, 6.0},
+        {create_point(0.5, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 4.0, 6.0},
+        {create_point(0.0, 0.5, 0.0), create_vector(0.0, 0.0, 1.0), -1.0, 1.0}
+    };
+    
+    for (const auto& [origin, direction, t1, t2] : cases) {
+        auto hits = c.intersects(Ray(origin, direction));
+        ASSERT_EQ(hits.size(), 2);
+        EXPECT_EQ(hits[0].t, t1);
+        EXPECT_EQ(hits[1].t, t2);
+    }
+}
+
+TEST(CubeTest, RayMissesCube) {
+    Cube c;
+    const std::vector<std::pair<Tuple, Tuple>> cases = {
+        {create_point(-2.0, 0.0, 0.0), create_vector(0.2673, 0.5345, 0.8018)},
+        {create_point(0.0, -2.0, 0.0), create_vector(0.8018, 0.2673, 0.5345)},
+        {create_point(0.0, 0.0, -2.0), create_vector(0.5345, 0.8018, 0.2673)},
+        {create_point(2.0, 0.0, 2.0), create_vector(0.0, 0.0, -1.0)},
+        {create_point(0.0, 2.0, 2.0), create_vector(0.0, -1.0, 0.0)},
+        {create_point(2.0, 2.0, 0.0), create_vector(-1.0, 0.0, 0.0)}
+    };
+    
+    for (const auto& [origin, direction] : cases) {
+        EXPECT_TRUE(c.intersects(Ray(origin, direction)).empty());
+    }
+}
+
+TEST(CubeTest, NormalOnSurface) {
+    Cube c;
+    EXPECT_EQ(c.normalAt(create_point(1.0, 0.5, -0.8)), create_vector(1.0, 0.0, 0.0));
+    EXPECT_EQ(c.normalAt(create_point(-1.0, -0.2, 0.9)), create_vector(-1.0, 0.0, 0.0));
+    EXPECT_EQ(c.normalAt(create_point(-0.4, 1.0, -0.1)), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(c.normalAt(create_point(0.3, -1.0, -0.7)), create_vector(0.0, -1.0, 0.0));
+    EXPECT_EQ(c.normalAt(create_point(-0.6, 0.3, 1.0)), create_vector(0.0, 0.0, 1.0));
+    EXPECT_EQ(c.normalAt(create_point(0.4, 0.4, -1.0)), create_vector(0.0, 0.0, -1.0));
+    EXPECT_EQ(c.normalAt(create_point(1.0, 1.0, 1.0)), create_vector(1.0, 0.0, 0.0));
+    EXPECT_EQ(c.normalAt(create_point(-1.0, -1.0, -1.0)), create_vector(-1.0, 0.0, 0.0));
+}
+
+TEST(CubeTest, Bounds) {
+    Cube c;
+    EXPECT_EQ(c.localBounds(), BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0)));
+}
+
+}
@@ -0,0 +1,109 @@
+//
+//  cylinder_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "cylinder.hpp"
+
+#include <limits>
+
+using namespace rtlib;
+
+namespace {
+
+TEST(CylinderTest, RayMissesCylinder) {
+    Cylinder cyl;
+    const std::vector<std::pair<Tuple, Tuple>> cases = {
+        {create_point(1.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)},
+        {create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)},
+        {create_point(0.0, 0.0, -5.0), create_vector(1.0, 1.0, 1.0)}
+    };
+    
+    for (const auto& [origin, direction] : cases) {
+        EXPECT_TRUE(cyl.intersects(Ray(origin, direction.normalised())).empty());
+    }
+}
+
+TEST(CylinderTest, RayStrikesCylinder) {
+    Cylinder cyl;
+    const std::vector<std::tuple<Tuple, Tuple, double, double>> cases = {
+        {create_point(1.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 5.0, 5.0},
+        {create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 4.0, 6.0},
+        {create_point(0.5, 0.0, -5.0), create_vector(0.1, 1.0, 1.0), 6.80798, 7.08872}
+    };
+    
+    for (const auto& [origin, direction, t0, t1] : cases) {
+        auto hits = cyl.intersects(Ray(origin, direction.normalised()));
+        ASSERT_EQ(hits.size(), 2);
+        EXPECT_NEAR(hits[0].t, t0, 0.0001);
+        EXPECT_NEAR(hits[1].t, t1, 0.0001);
+    }
+}
+
+TEST(CylinderTest, NormalOnWall) {
+    Cylinder cyl;
+    EXPECT_EQ(cyl.normalAt(create_point(1.0, 0.0, 0.0)), create_vector(1.0, 0.0, 0.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.0, 5.0, -1.0)), create_vector(0.0, 0.0, -1.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.0, -2.0, 1.0)), create_vector(0.0, 0.0, 1.0));
+    EXPECT_EQ(cyl.normalAt(create_point(-1.0, 1.0, 0.0)), create_vector(-1.0, 0.0, 0.0));
+}
+
+TEST(CylinderTest, DefaultsToInfiniteAndOpen) {
+    Cylinder cyl;
+    EXPECT_EQ(cyl.minimum(), -std::numeric_limits<double>::infinity());
+    EXPECT_EQ(cyl.maximum(), std::numeric_limits<double>::infinity());
+    EXPECT_FALSE(cyl.closed());
+    EXPECT_FALSE(cyl.localBounds().finite());
+}
+
+TEST(CylinderTest, IntersectingTruncatedCylinder) {
+    Cylinder cyl(1.0, 2.0);
+    const std::vector<std::tuple<Tuple, Tuple, unsigned int>> cases = {
+        {create_point(0.0, 1.5, 0.0), create_vector(0.1, 1.0, 0.0), 0},
+        {create_point(0.0, 3.0, -5.0), create_vector(0.0, 0.0, 1.0), 0},
+        {create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 0},
+        {create_point(0.0, 2.0, -5.0), create_vector(0.0, 0.0, 1.0), 0},
+        {create_point(0.0, 1.0, -5.0), create_vector(0.0, 0.0, 1.0), 0},
+        {create_point(0.0, 1.5, -2.0), create_vector(0.0, 0.0, 1.0), 2}
+    };
+    
+    for (const auto& [origin, direction, count] : cases) {
+        EXPECT_EQ(cyl.intersects(Ray(origin, direction.normalised())).size(), count);
+    }
+}
+
+TEST(CylinderTest, IntersectingCaps) {
+    Cylinder cyl(1.0, 2.0, true);
+    const std::vector<std::tuple<Tuple, Tuple, unsigned int>> cases = {
+        {create_point(0.0, 3.0, 0.0), create_vector(0.0, -1.0, 0.0), 2},
+        {create_point(0.0, 3.0, -2.0), create_vector(0.0, -1.0, 2.0), 2},
+        {create_point(0.0, 4.0, -2.0), create_vector(0.0, -1.0, 1.0), 2},
+        {create_point(0.0, 0.0, -2.0), create_vector(0.0, 1.0, 2.0), 2},
+        {create_point(0.0, -1.0, -2.0), create_vector(0.0, 1.0, 1.0), 2}
+    };
+    
+    for (const auto& [origin, direction, count] : cases) {
+        EXPECT_EQ(cyl.intersects(Ray(origin, direction.normalised())).size(), count);
+    }
+}
+
+TEST(CylinderTest, NormalOnCaps) {
+    Cylinder cyl(1.0, 2.0, true);
+    EXPECT_EQ(cyl.normalAt(create_point(0.0, 1.0, 0.0)), create_vector(0.0, -1.0, 0.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.5, 1.0, 0.0)), create_vector(0.0, -1.0, 0.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.0, 1.0, 0.5)), create_vector(0.0, -1.0, 0.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.0, 2.0, 0.0)), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.5, 2.0, 0.0)), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(cyl.normalAt(create_point(0.0, 2.0, 0.5)), create_vector(0.0, 1.0, 0.0));
+}
+
+TEST(CylinderTest, TruncatedBounds) {
+    Cylinder cyl(1.0, 2.0, true);
+    EXPECT_EQ(cyl.localBounds(), BoundingBox(create_point(-1.0, 1.0, -1.0), create_point(1.0, 2.0, 1.0)));
+}
+
+}
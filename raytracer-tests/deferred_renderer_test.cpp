@@ -0,0 +1,178 @@
+//
+//  deferred_renderer_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "deferred_renderer.hpp"
+
+#include "integrator.hpp"
+#include "lighting.hpp"
+#include "pattern.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+Camera testCamera() {
+    Camera camera(20, 14, std::numbers::pi / 3.0);
+    camera.setTransform(viewTransform(create_point(0.0, 1.5, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    return camera;
+}
+
+std::unique_ptr<World> glassAndMirrorWorld() {
+    auto world = World::defaultWorld();
+    world->objects().front()->material()._pattern = std::make_shared<StripePattern>(Colour(1.0, 0.0, 0.0), Colour(0.0, 0.0, 1.0));
+    
+    auto floor = std::make_unique<Plane>();
+    floor->setTransform(translation(0.0, -1.0, 0.0));
+    floor->material()._reflective = 0.5;
+    world->addObject(std::move(floor));
+    
+    auto glass = std::make_unique<Sphere>();
+    glass->setTransform(translation(1.5, 0.0, -1.0) * scaling(0.75, 0.75, 0.75));
+    glass->material()._reflective = 0.9;
+    glass->material()._transparency = 0.9;
+    glass->material()._refractiveIndex = 1.5;
+    world->addObject(std::move(glass));
+    
+    return world;
+}
+
+void expectMatchesIntegrator(const World& world, unsigned int tileSize) {
+    auto camera = testCamera();
+    DeferredRenderer::Settings settings;
+    settings.tileSize = tileSize;
+    DeferredRenderer renderer(world, camera, settings);
+    
+    Canvas canvas(camera.horizontalSize(), camera.verticalSize());
+    renderer.render(canvas);
+    
+    Integrator integrator(world);
+    for (unsigned int y = 0; y < camera.verticalSize(); y++) {
+        for (unsigned int x = 0; x < camera.horizontalSize(); x++) {
+            EXPECT_EQ(canvas.pixelAt(x, y), integrator.colourAt(camera.rayForPixel(x, y))) << x << ", " << y;
+        }
+    }
+}
+
+TEST(DeferredRendererTest, OpaqueSceneMatchesIntegrator) {
+    auto world = World::defaultWorld();
+    expectMatchesIntegrator(*world, 16);
+}
+
+TEST(DeferredRendererTest, ReflectionAndRefractionMatchIntegrator) {
+    auto world = glassAndMirrorWorld();
+    expectMatchesIntegrator(*world, 16);
+    expectMatchesIntegrator(*world, 3);
+}
+
+TEST(DeferredRendererTest, HitsBatchedByMaterial) {
+    //the outer sphere of the default world hides the inner one, the floor adds a second material
+    auto world = World::defaultWorld();
+    auto floor = std::make_unique<Plane>();
+    floor->setTransform(translation(0.0, -1.0, 0.0));
+    world->addObject(std::move(floor));
+    
+    auto camera = testCamera();
+    DeferredRenderer renderer(*world, camera);
+    
+    Canvas canvas(camera.horizontalSize(), camera.verticalSize());
+    auto stats = renderer.renderTile(canvas, 0, 0, camera.horizontalSize(), camera.verticalSize());
+    EXPECT_EQ(stats.waves, 1);
+    EXPECT_EQ(stats.batches, 2);
+    EXPECT_GT(stats.hits, 0);
+    
+    //equal shading parameters make one batch whichever object they're on
+    world->objects().back()->setMaterial(world->objects().front()->material());
+    stats = renderer.renderTile(canvas, 0, 0, camera.horizontalSize(), camera.verticalSize());
+    EXPECT_EQ(stats.batches, 1);
+}
+
+TEST(DeferredRendererTest, SecondaryRaysTracedAsNewWaves) {
+    auto world = glassAndMirrorWorld();
+    auto camera = testCamera();
+    DeferredRenderer renderer(*world, camera);
+    
+    Canvas canvas(camera.horizontalSize(), camera.verticalSize());
+    auto stats = renderer.renderTile(canvas, 0, 0, camera.horizontalSize(), camera.verticalSize());
+    EXPECT_GT(stats.waves, 1);
+    EXPECT_GT(stats.hits, camera.horizontalSize() * camera.verticalSize());
+}
+
+TEST(DeferredRendererTest, SortedSecondaryRaysGiveSameImage) {
+    auto world = glassAndMirrorWorld();
+    auto camera = testCamera();
+    
+    Canvas unsorted(camera.horizontalSize(), camera.verticalSize());
+    DeferredRenderer(*world, camera).render(unsorted);
+    
+    DeferredRenderer::Settings settings;
+    settings.sortSecondaryRays = true;
+    Canvas sorted(camera.horizontalSize(), camera.verticalSize());
+    DeferredRenderer(*world, camera, settings).render(sorted);
+    
+    for (unsigned int y = 0; y < camera.verticalSize(); y++) {
+        for (unsigned int x = 0; x < camera.horizontalSize(); x++) {
+            EXPECT_EQ(sorted.pixelAt(x, y), unsorted.pixelAt(x, y));
+        }
+    }
+}
+
+TEST(DeferredRendererTest, FrustumCullingGivesSameImage) {
+    //a row of spheres across the view, most tiles only see a few of them
+    auto world = glassAndMirrorWorld();
+    for (int i = -4; i <= 4; i++) {
+        auto sphere = std::make_unique<Sphere>();
+        sphere->setTransform(translation(i * 0.8, 1.0, 1.0) * scaling(0.3, 0.3, 0.3));
+        sphere->material()._reflective = 0.3;
+        world->addObject(std::move(sphere));
+    }
+    
+    auto camera = testCamera();
+    DeferredRenderer::Settings settings;
+    settings.tileSize = 4;
+    settings.frustumCulling = false;
+    Canvas unculled(camera.horizontalSize(), camera.verticalSize());
+    DeferredRenderer(*world, camera, settings).render(unculled);
+    
+    settings.frustumCulling = true;
+    DeferredRenderer renderer(*world, camera, settings);
+    Canvas culled(camera.horizontalSize(), camera.verticalSize());
+    renderer.render(culled);
+    
+    for (unsigned int y = 0; y < camera.verticalSize(); y++) {
+        for (unsigned int x = 0; x < camera.horizontalSize(); x++) {
+            EXPECT_EQ(culled.pixelAt(x, y), unculled.pixelAt(x, y)) << x << ", " << y;
+        }
+    }
+    
+    auto stats = renderer.renderTile(culled, 0, 0, 4, 4);
+    EXPECT_GT(stats.candidates, 0);
+    EXPECT_LT(stats.candidates, world->objects().size());
+    
+    world->buildBVH();
+    stats = renderer.renderTile(culled, 0, 0, 4, 4);
+    EXPECT_EQ(stats.candidates, 0);
+}
+
+TEST(DeferredRendererTest, MoreThanOneLightThrows) {
+    auto world = World::defaultWorld();
+    world->addLight(std::make_unique<Light>(create_point(10.0, 10.0, -10.0), Colour(1.0, 1.0, 1.0)));
+    auto camera = testCamera();
+    DeferredRenderer renderer(*world, camera);
+    
+    Canvas canvas(camera.horizontalSize(), camera.verticalSize());
+    EXPECT_THROW(renderer.render(canvas), std::runtime_error);
+}
+
+}
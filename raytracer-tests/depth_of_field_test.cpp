@@ -0,0 +1,93 @@
+//
+//  depth_of_field_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "depth_of_field.hpp"
+
+#include "lighting.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+//a wall facing the camera five units away, with a sphere in front of its middle
+std::unique_ptr<World> wallWorld(bool withSphere) {
+    auto world = std::make_unique<World>();
+    world->addLight(std::make_unique<Light>(create_point(-2.0, 2.0, 0.0), Colour(1.0, 1.0, 1.0)));
+    
+    auto wall = std::make_unique<Plane>();
+    wall->setTransform(translation(0.0, 0.0, -5.0) * rotation_x(std::numbers::pi / 2.0));
+    world->addObject(std::move(wall));
+    
+    if (withSphere) {
+        auto sphere = std::make_unique<Sphere>();
+        sphere->setTransform(translation(0.0, 0.0, -2.5) * scaling(0.5, 0.5, 0.5));
+        world->addObject(std::move(sphere));
+    }
+    
+    return world;
+}
+
+TEST(DepthOfFieldTest, InFocusPixelsTakeOnlyTheProbe) {
+    auto world = wallWorld(false);
+    Camera camera(10, 8, std::numbers::pi / 3.0);
+    camera.setLens(0.1, 5.0);
+    
+    AccumulationBuffer buffer(10, 8);
+    DepthOfFieldRenderer renderer(*world, camera, std::make_shared<StratifiedSampler>(16));
+    auto stats = renderer.accumulate(buffer);
+    
+    EXPECT_EQ(stats.pixelsInFocus, 80);
+    EXPECT_EQ(stats.pixelsRefined, 0);
+    EXPECT_EQ(stats.lensSamples, 80 * 4);
+    EXPECT_EQ(buffer.sampleCount(3, 5), 4);
+}
+
+TEST(DepthOfFieldTest, OutOfFocusPixelsTakeEveryStratum) {
+    auto world = wallWorld(true);
+    Camera camera(10, 8, std::numbers::pi / 3.0);
+    camera.setLens(0.1, 5.0);
+    
+    AccumulationBuffer buffer(10, 8);
+    DepthOfFieldRenderer renderer(*world, camera, std::make_shared<StratifiedSampler>(16));
+    auto stats = renderer.accumulate(buffer);
+    
+    //the sphere is out of focus, the wall around it isn't
+    EXPECT_GT(stats.pixelsInFocus, 0);
+    EXPECT_GT(stats.pixelsRefined, 0);
+    EXPECT_EQ(stats.lensSamples, stats.pixelsInFocus * 4 + stats.pixelsRefined * 20);
+    EXPECT_EQ(buffer.sampleCount(0, 0), 4);
+    EXPECT_EQ(buffer.sampleCount(5, 4), 20);
+}
+
+TEST(DepthOfFieldTest, NonAdaptiveSamplesWholeLens) {
+    auto world = wallWorld(true);
+    Camera camera(10, 8, std::numbers::pi / 3.0);
+    camera.setLens(0.1, 5.0);
+    
+    DepthOfFieldRenderer::Settings settings;
+    settings.adaptive = false;
+    settings.lensStrata = 3;
+    
+    AccumulationBuffer buffer(10, 8);
+    DepthOfFieldRenderer renderer(*world, camera, std::make_shared<SobolSampler>(), settings);
+    auto stats = renderer.accumulate(buffer, 2, 5);
+    
+    EXPECT_EQ(stats.pixelsRefined, 30);
+    EXPECT_EQ(stats.lensSamples, 30 * 9);
+    EXPECT_EQ(buffer.sampleCount(0, 1), 0);
+    EXPECT_EQ(buffer.sampleCount(0, 2), 9);
+}
+
+}
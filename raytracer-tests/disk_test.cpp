@@ -0,0 +1,49 @@
+//
+//  disk_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "disk.hpp"
+#include "transformations.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+TEST(DiskTest, RayThroughDisk) {
+    Disk d;
+    auto hits = d.intersects(Ray(create_point(0.5, 1.0, 0.5), create_vector(0.0, -1.0, 0.0)));
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].t, 1.0);
+    EXPECT_EQ(hits[0].object, &d);
+}
+
+TEST(DiskTest, RayOutsideRadiusMisses) {
+    Disk d;
+    EXPECT_TRUE(d.intersects(Ray(create_point(0.8, 1.0, 0.8), create_vector(0.0, -1.0, 0.0))).empty());
+}
+
+TEST(DiskTest, RayParallelMisses) {
+    Disk d;
+    EXPECT_TRUE(d.intersects(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0))).empty());
+}
+
+TEST(DiskTest, NormalFacesUp) {
+    Disk d;
+    d.setTransform(rotation_x(std::numbers::pi / 2.0));
+    EXPECT_EQ(d.normalAt(create_point(0.0, 0.0, 0.0)), create_vector(0.0, 0.0, 1.0));
+}
+
+TEST(DiskTest, BoundsAreFlat) {
+    Disk d;
+    d.setTransform(scaling(2.0, 1.0, 2.0));
+    EXPECT_EQ(d.bounds(), BoundingBox(create_point(-2.0, 0.0, -2.0), create_point(2.0, 0.0, 2.0)));
+}
+
+}
@@ -0,0 +1,244 @@
+//
+//  integrator_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "camera.hpp"
+#include "integrator.hpp"
+#include "pattern.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+//the recursive form the integrator replaces
+Colour recursiveColourAt(const World& world, const Ray& ray, unsigned int remaining) {
+    auto values = world.hitValuesAt(ray);
+    if (!values) {
+        return Colour();
+    }
+    
+    auto material = values->intersect.object->materialAt(values->intersect);
+    Colour reflected;
+    if (remaining > 0 && material._reflective > 0.0) {
+        reflected = recursiveColourAt(world, Ray(values->overPoint, values->reflectionVector()), remaining - 1) * material._reflective;
+    }
+    
+    Colour refracted;
+    auto refractRay = refractedRay(*values);
+    if (remaining > 0 && material._transparency > 0.0 && refractRay) {
+        refracted = recursiveColourAt(world, *refractRay, remaining) * material._transparency;
+    }
+    
+    if (material._reflective > 0.0 && material._transparency > 0.0) {
+        auto reflectance = schlickReflectance(*values);
+        return world.surfaceColourAt(*values) + reflected * reflectance + refracted * (1 - reflectance);
+    }
+    
+    return world.surfaceColourAt(*values) + reflected + refracted;
+}
+
+std::unique_ptr<World> glassAndMirrorWorld() {
+    auto world = World::defaultWorld();
+    
+    auto floor = std::make_unique<Plane>();
+    floor->setTransform(translation(0.0, -1.0, 0.0));
+    floor->material()._reflective = 0.5;
+    world->addObject(std::move(floor));
+    
+    auto glass = std::make_unique<Sphere>();
+    glass->setTransform(translation(1.5, 0.0, -1.0) * scaling(0.75, 0.75, 0.75));
+    glass->material()._reflective = 0.9;
+    glass->material()._transparency = 0.9;
+    glass->material()._refractiveIndex = 1.5;
+    world->addObject(std::move(glass));
+    
+    return world;
+}
+
+std::unique_ptr<World> mirrorCorridorWorld(double reflective) {
+    auto world = World::defaultWorld();
+    *world->lights().at(0) = Light(create_point(0.0, 0.0, 0.0), Colour(1.0, 1.0, 1.0));
+    
+    auto lower = std::make_unique<Plane>();
+    lower->material()._reflective = reflective;
+    lower->setTransform(translation(0.0, -1.0, 0.0));
+    world->addObject(std::move(lower));
+    
+    auto upper = std::make_unique<Plane>();
+    upper->material()._reflective = reflective;
+    upper->setTransform(translation(0.0, 1.0, 0.0));
+    world->addObject(std::move(upper));
+    
+    return world;
+}
+
+TEST(IntegratorTest, RayMissIsBlack) {
+    auto world = World::defaultWorld();
+    Integrator integrator(*world);
+    EXPECT_EQ(integrator.colourAt(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 1.0, 0.0))), Colour(0.0, 0.0, 0.0));
+}
+
+TEST(IntegratorTest, ReflectiveTransparentMaterial) {
+    auto world = World::defaultWorld();
+    
+    auto floor = std::make_unique<Plane>();
+    floor->setTransform(translation(0.0, -1.0, 0.0));
+    floor->material()._reflective = 0.5;
+    floor->material()._transparency = 0.5;
+    floor->material()._refractiveIndex = 1.5;
+    world->addObject(std::move(floor));
+    
+    auto ball = std::make_unique<Sphere>();
+    ball->setTransform(translation(0.0, -3.5, -0.5));
+    ball->material()._ambient = 0.5;
+    ball->material()._colour = Colour(1.0, 0.0, 0.0);
+    world->addObject(std::move(ball));
+    
+    Integrator integrator(*world);
+    auto ray = Ray(create_point(0.0, 0.0, -3.0), create_vector(0.0, -std::sqrt(2.0)/2.0, std::sqrt(2.0)/2.0));
+    EXPECT_EQ(integrator.colourAt(ray), Colour(0.93391, 0.69643, 0.69243));
+}
+
+TEST(IntegratorTest, MatchesRecursiveColourAt) {
+    auto world = glassAndMirrorWorld();
+    Integrator integrator(*world);
+    
+    Camera camera(16, 12, std::numbers::pi / 3.0);
+    camera.setTransform(viewTransform(create_point(0.0, 1.5, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    
+    for (unsigned int y = 0; y < camera.verticalSize(); y++) {
+        for (unsigned int x = 0; x < camera.horizontalSize(); x++) {
+            auto ray = camera.rayForPixel(x, y);
+            for (unsigned int remaining : {0, 1, 5}) {
+                EXPECT_EQ(integrator.colourAt(ray, remaining), recursiveColourAt(*world, ray, remaining));
+            }
+        }
+    }
+}
+
+TEST(IntegratorTest, MutuallyReflectiveSurfacesTerminate) {
+    auto world = mirrorCorridorWorld(1.0);
+    Integrator integrator(*world);
+    auto ray = Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(integrator.colourAt(ray, 10), recursiveColourAt(*world, ray, 10));
+}
+
+TEST(IntegratorTest, DeepChainsOutgrowFixedStack) {
+    //dense glass reflects nearly everything head on, each bounce leaves a refracted ray
+    //waiting on the stack while the reflection carries on
+    World world;
+    world.addLight(std::make_unique<Light>(create_point(0.5, 0.0, 0.0), Colour(1.0, 1.0, 1.0)));
+    for (auto y : {-1.0, 1.0}) {
+        auto pane = std::make_unique<Plane>();
+        pane->setTransform(translation(0.0, y, 0.0));
+        pane->material()._reflective = 1.0;
+        pane->material()._transparency = 1.0;
+        pane->material()._refractiveIndex = y > 0.0 ? 1000.0 : 1.0;
+        world.addObject(std::move(pane));
+    }
+    
+    Integrator integrator(world);
+    auto ray = Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0));
+    auto remaining = Integrator::maxPendingRays + 20;
+    auto colour = integrator.colourAt(ray, remaining);
+    auto expected = recursiveColourAt(world, ray, remaining);
+    EXPECT_NEAR(colour.red(), expected.red(), 1e-6);
+    EXPECT_GT(colour.red(), integrator.colourAt(ray, Integrator::maxPendingRays).red() + 0.5);
+}
+
+TEST(IntegratorTest, HandsBackThePrimaryHit) {
+    auto world = glassAndMirrorWorld();
+    Integrator integrator(*world);
+    Ray ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    
+    std::optional<IntersectValues> primary;
+    auto colour = integrator.colourAt(ray, 5, primary);
+    EXPECT_EQ(colour, integrator.colourAt(ray, 5));
+    
+    auto expected = world->hitValuesAt(ray);
+    ASSERT_TRUE(primary.has_value());
+    EXPECT_EQ(primary->intersect.object, expected->intersect.object);
+    EXPECT_EQ(primary->point, expected->point);
+    
+    integrator.colourAt(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 1.0, 0.0)), 5, primary);
+    EXPECT_FALSE(primary.has_value());
+}
+
+TEST(IntegratorTest, DimRaysDropped) {
+    //bounces weigh 0.5, 0.25, 0.125 then 0.0625 which is under the threshold
+    auto world = mirrorCorridorWorld(0.5);
+    Integrator integrator(*world, 0.1);
+    auto ray = Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(integrator.colourAt(ray, 10), recursiveColourAt(*world, ray, 3));
+}
+
+TEST(IntegratorTest, RussianRouletteAveragesToFullDepth) {
+    auto world = mirrorCorridorWorld(0.5);
+    Integrator integrator(*world, 0.3, true);
+    auto ray = Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0));
+    
+    const unsigned int samples = 4000;
+    Colour sum;
+    for (unsigned int i = 0; i < samples; i++) {
+        sum = sum + integrator.colourAt(ray, 10);
+    }
+    
+    auto expected = recursiveColourAt(*world, ray, 10);
+    EXPECT_NEAR(sum.red() / samples, expected.red(), 0.01);
+    EXPECT_NEAR(sum.green() / samples, expected.green(), 0.01);
+    EXPECT_NEAR(sum.blue() / samples, expected.blue(), 0.01);
+}
+
+TEST(IntegratorTest, FeaturesFollowMaterials) {
+    auto world = World::defaultWorld();
+    auto features = world->features();
+    EXPECT_FALSE(features.reflection);
+    EXPECT_FALSE(features.transparency);
+    EXPECT_FALSE(features.patterns);
+    
+    world->objects().front()->material()._pattern = std::make_shared<StripePattern>(Colour(1.0, 0.0, 0.0), Colour(0.0, 0.0, 1.0));
+    EXPECT_TRUE(world->features().patterns);
+    
+    features = glassAndMirrorWorld()->features();
+    EXPECT_TRUE(features.reflection);
+    EXPECT_TRUE(features.transparency);
+    EXPECT_FALSE(features.patterns);
+}
+
+TEST(IntegratorTest, SpecialisedKernelsMatchGeneral) {
+    std::vector<std::unique_ptr<World>> worlds;
+    worlds.push_back(World::defaultWorld());
+    worlds.push_back(mirrorCorridorWorld(0.5));
+    worlds.push_back(glassAndMirrorWorld());
+    
+    worlds.push_back(World::defaultWorld());
+    worlds.back()->objects().front()->material()._pattern = std::make_shared<StripePattern>(Colour(1.0, 0.0, 0.0), Colour(0.0, 0.0, 1.0));
+    
+    Camera camera(16, 12, std::numbers::pi / 3.0);
+    camera.setTransform(viewTransform(create_point(0.0, 1.5, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    
+    for (const auto& world : worlds) {
+        Integrator specialised(*world);
+        Integrator general(*world, SceneFeatures());
+        
+        for (unsigned int y = 0; y < camera.verticalSize(); y++) {
+            for (unsigned int x = 0; x < camera.horizontalSize(); x++) {
+                auto ray = camera.rayForPixel(x, y);
+                EXPECT_EQ(specialised.colourAt(ray), general.colourAt(ray));
+            }
+        }
+    }
+}
+
+}
@@ -31,7 +31,7 @@ TEST(IntersectionTest, PrecomputeReflectionVector) {
     auto intersect = Intersect(&plane, std::sqrt(2.0));
     auto intersectValues = IntersectValues(intersect, ray);
     
-    EXPECT_EQ(intersectValues.reflectionVector, create_vector(0.0, std::sqrt(2.0)/2.0, std::sqrt(2.0)/2.0));
+    EXPECT_EQ(intersectValues.reflectionVector(), create_vector(0.0, std::sqrt(2.0)/2.0, std::sqrt(2.0)/2.0));
 }
 
 TEST(IntersectionTest, ComputeRefractiveN1andN2AtVariousIntersections) {
@@ -93,6 +93,53 @@ TEST(IntersectionTest, UnderPointIsOffsetBelowTheSurface) {
     EXPECT_TRUE(intersectValues.overPoint.z() < intersectValues.underPoint.z());
 }
 
+TEST(IntersectionTest, OpaqueHitSkipsRefractionData) {
+    auto glass = glassSphere();
+    glass->setTransform(scaling(2.0, 2.0, 2.0));
+    auto opaque = std::make_shared<Sphere>();
+    
+    auto ray = Ray(create_point(0.0, 0.0, -4.0), create_vector(0.0, 0.0, 1.0));
+    auto intersections = Intersections();
+    intersections.push_back(Intersect(glass.get(), 2.0));
+    intersections.push_back(Intersect(opaque.get(), 3.0));
+    intersections.push_back(Intersect(opaque.get(), 5.0));
+    intersections.push_back(Intersect(glass.get(), 6.0));
+    
+    auto values = IntersectValues(intersections[1], ray, intersections);
+    EXPECT_EQ(values.refractiveIndexN1, 1.0);
+    EXPECT_EQ(values.refractiveIndexN2, 1.0);
+    EXPECT_EQ(values.underPoint, values.overPoint);
+    EXPECT_EQ(values.reflectionVector(), create_vector(0.0, 0.0, -1.0));
+}
+
+TEST(IntersectionTest, DeeplyNestedShellsKeepTheirRefractiveIndices) {
+    //more shells than the fixed container stack holds
+    std::vector<std::shared_ptr<Sphere>> shells;
+    for (int i = 0; i < 40; i++) {
+        auto shell = glassSphere();
+        shell->setTransform(scaling(40.0 - i, 40.0 - i, 40.0 - i));
+        shell->material()._refractiveIndex = 1.0 + i * 0.01;
+        shells.push_back(shell);
+    }
+    
+    auto ray = Ray(create_point(0.0, 0.0, -50.0), create_vector(0.0, 0.0, 1.0));
+    auto intersections = Intersections();
+    for (int i = 0; i < 40; i++) {
+        intersections.push_back(Intersect(shells[i].get(), 10.0 + i));
+    }
+    for (int i = 39; i >= 0; i--) {
+        intersections.push_back(Intersect(shells[i].get(), 90.0 - i));
+    }
+    
+    auto entering = IntersectValues(intersections[39], ray, intersections);
+    EXPECT_DOUBLE_EQ(entering.refractiveIndexN1, 1.38);
+    EXPECT_DOUBLE_EQ(entering.refractiveIndexN2, 1.39);
+    
+    auto leaving = IntersectValues(intersections[40], ray, intersections);
+    EXPECT_DOUBLE_EQ(leaving.refractiveIndexN1, 1.39);
+    EXPECT_DOUBLE_EQ(leaving.refractiveIndexN2, 1.38);
+}
+
 TEST(IntersectionTest, SchlickReflectanceUnderTotalInternalReflection) {
     const auto srt2over2 = std::sqrt(2.0) / 2.0;
     
@@ -0,0 +1,87 @@
+//
+//  light_bvh_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "area_light.hpp"
+#include "light_bvh.hpp"
+
+#include <cmath>
+
+using namespace rtlib;
+
+namespace {
+
+//a row of lights above the xz plane and two below it
+std::vector<std::unique_ptr<Light>> lightRow() {
+    std::vector<std::unique_ptr<Light>> lights;
+    for (int i = 0; i < 8; i++) {
+        lights.push_back(std::make_unique<Light>(create_point(i * 2.0 - 7.0, 5.0, 0.0), Colour(1.0, 1.0, 1.0) * (1.0 + i)));
+    }
+    lights.push_back(std::make_unique<Light>(create_point(0.0, -5.0, 0.0), Colour(1.0, 1.0, 1.0)));
+    lights.push_back(std::make_unique<SphereLight>(create_point(3.0, -5.0, 1.0), 0.5, Colour(1.0, 1.0, 1.0)));
+    return lights;
+}
+
+TEST(LightBVHTest, EmptyHasNothingToSample) {
+    LightBVH tree(std::vector<std::unique_ptr<Light>>{});
+    EXPECT_EQ(tree.power(), 0.0);
+    EXPECT_FALSE(tree.sample(create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0), 0.5));
+}
+
+TEST(LightBVHTest, PowerSumsLuminance) {
+    auto lights = lightRow();
+    LightBVH tree(lights);
+    EXPECT_NEAR(tree.power(), 36.0 + 2.0, 1e-9);
+}
+
+TEST(LightBVHTest, PmfSumsToOneAndSkipsLightsBehind) {
+    auto lights = lightRow();
+    LightBVH tree(lights);
+    auto point = create_point(0.5, 0.0, 0.0);
+    auto normal = create_vector(0.0, 1.0, 0.0);
+    
+    double total = 0.0;
+    for (unsigned int i = 0; i < lights.size(); i++) {
+        total += tree.pmf(point, normal, i);
+    }
+    
+    EXPECT_NEAR(total, 1.0, 1e-9);
+    EXPECT_EQ(tree.pmf(point, normal, 8), 0.0);
+    EXPECT_EQ(tree.pmf(point, normal, 9), 0.0);
+}
+
+TEST(LightBVHTest, SamplesMatchPmf) {
+    auto lights = lightRow();
+    LightBVH tree(lights);
+    auto point = create_point(0.5, 0.0, 0.0);
+    auto normal = create_vector(0.0, 1.0, 0.0);
+    
+    const unsigned int samples = 10000;
+    std::vector<unsigned int> counts(lights.size(), 0);
+    for (unsigned int i = 0; i < samples; i++) {
+        auto picked = tree.sample(point, normal, (i + 0.5) / samples);
+        ASSERT_TRUE(picked);
+        EXPECT_NEAR(picked->pmf, tree.pmf(point, normal, picked->light), 1e-12);
+        counts[picked->light]++;
+    }
+    
+    for (unsigned int i = 0; i < lights.size(); i++) {
+        EXPECT_NEAR(counts[i] / static_cast<double>(samples), tree.pmf(point, normal, i), 1e-3);
+    }
+    
+    //brighter lights straight overhead are picked more often
+    EXPECT_GT(counts[4], counts[3]);
+}
+
+TEST(LightBVHTest, NothingWhenAllLightsAreBehind) {
+    auto lights = lightRow();
+    LightBVH tree(lights);
+    EXPECT_FALSE(tree.sample(create_point(0.0, 10.0, 0.0), create_vector(0.0, 1.0, 0.0), 0.3));
+}
+
+}
@@ -0,0 +1,162 @@
+//
+//  light_resampler_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "light_resampler.hpp"
+
+#include "lighting.hpp"
+#include "plane.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+Camera floorCamera() {
+    Camera camera(24, 16, std::numbers::pi / 3.0);
+    camera.setTransform(viewTransform(create_point(0.0, 3.0, -6.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    return camera;
+}
+
+//a floor under a grid of dim lights of varying colour
+std::unique_ptr<World> manyLightWorld() {
+    auto world = std::make_unique<World>();
+    for (int i = 0; i < 24; i++) {
+        auto position = create_point((i % 6) * 2.0 - 5.0, 3.0 + (i % 3), (i / 6) * 2.0 - 3.0);
+        world->addLight(std::make_unique<Light>(position, Colour(0.02 * (1 + i % 5), 0.03, 0.01 * (1 + i % 3))));
+    }
+    
+    auto floor = std::make_unique<Plane>();
+    floor->material()._specular = 0.0;
+    world->addObject(std::move(floor));
+    return world;
+}
+
+//every light shaded at every pixel, what resampling estimates
+Colour reference(const World& world, const Camera& camera, unsigned int x, unsigned int y) {
+    auto values = world.hitValuesAt(camera.rayForPixel(x, y));
+    if (!values) {
+        return Colour(0.0, 0.0, 0.0);
+    }
+    
+    auto material = values->intersect.object->materialAt(values->intersect);
+    auto colour = material.colourAt(values->intersect.object, values->point);
+    Colour total;
+    for (const auto& light : world.lights()) {
+        total = total + light->lightPoint(material, colour, values->point, values->vectorToEye, values->normal, world.lightVisibility(*light, values->overPoint));
+    }
+    
+    return total;
+}
+
+TEST(LightResamplerTest, SingleLightMatchesWhittedShading) {
+    auto world = World::defaultWorld();
+    auto camera = floorCamera();
+    camera.setTransform(viewTransform(create_point(0.0, 0.0, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    LightResampler resampler(*world, camera, std::make_shared<SobolSampler>());
+    
+    Canvas canvas(24, 16);
+    for (unsigned int frame = 0; frame < 2; frame++) {
+        resampler.render(canvas);
+        for (unsigned int y = 0; y < 16; y++) {
+            for (unsigned int x = 0; x < 24; x++) {
+                EXPECT_EQ(canvas.pixelAt(x, y), world->colourAt(camera.rayForPixel(x, y), 0));
+            }
+        }
+    }
+}
+
+TEST(LightResamplerTest, ManyLightsConvergeOverFrames) {
+    auto world = manyLightWorld();
+    auto camera = floorCamera();
+    LightResampler::Settings settings;
+    settings.temporalReuse = false; //independent frames, so their average converges
+    LightResampler resampler(*world, camera, std::make_shared<SobolSampler>(), settings);
+    
+    const unsigned int frames = 16;
+    std::vector<Colour> sums(24 * 16);
+    Canvas canvas(24, 16);
+    for (unsigned int frame = 0; frame < frames; frame++) {
+        resampler.render(canvas);
+        for (unsigned int y = 0; y < 16; y++) {
+            for (unsigned int x = 0; x < 24; x++) {
+                sums[y * 24 + x] = sums[y * 24 + x] + canvas.pixelAt(x, y);
+            }
+        }
+    }
+    
+    double estimate = 0.0, expected = 0.0;
+    for (unsigned int y = 0; y < 16; y++) {
+        for (unsigned int x = 0; x < 24; x++) {
+            estimate += sums[y * 24 + x].luminance() / frames;
+            expected += reference(*world, camera, x, y).luminance();
+        }
+    }
+    
+    EXPECT_NEAR(estimate, expected, 0.03 * expected);
+}
+
+TEST(LightResamplerTest, TemporalReuseGrowsHistoryUpToLimit) {
+    auto world = manyLightWorld();
+    auto camera = floorCamera();
+    LightResampler::Settings settings;
+    settings.candidates = 4;
+    settings.spatialNeighbours = 0;
+    settings.historyLimit = 3;
+    LightResampler resampler(*world, camera, std::make_shared<SobolSampler>(), settings);
+    
+    Canvas canvas(24, 16);
+    resampler.render(canvas);
+    EXPECT_EQ(resampler.reservoirAt(12, 12).count, 4);
+    resampler.render(canvas);
+    EXPECT_EQ(resampler.reservoirAt(12, 12).count, 8);
+    for (unsigned int frame = 0; frame < 4; frame++) {
+        resampler.render(canvas);
+    }
+    EXPECT_EQ(resampler.reservoirAt(12, 12).count, 16);
+    EXPECT_EQ(resampler.frame(), 6);
+    
+    resampler.resetHistory();
+    resampler.render(canvas);
+    EXPECT_EQ(resampler.reservoirAt(12, 12).count, 4);
+}
+
+TEST(LightResamplerTest, MovedCameraReprojectsHistory) {
+    auto world = manyLightWorld();
+    auto camera = floorCamera();
+    LightResampler::Settings settings;
+    settings.candidates = 4;
+    settings.spatialNeighbours = 0;
+    LightResampler resampler(*world, camera, std::make_shared<SobolSampler>(), settings);
+    
+    Canvas canvas(24, 16);
+    resampler.render(canvas);
+    
+    //looking further along the floor, the top rows are new and the rest were seen last frame
+    camera.setTransform(viewTransform(create_point(0.0, 3.0, -6.0), create_point(0.0, 0.0, 0.5), create_vector(0.0, 1.0, 0.0)));
+    resampler.render(canvas);
+    EXPECT_EQ(resampler.reservoirAt(12, 14).count, 8);
+    EXPECT_EQ(resampler.reservoirAt(12, 0).count, 4);
+}
+
+TEST(LightResamplerTest, MissIsBlack) {
+    auto world = manyLightWorld();
+    auto camera = floorCamera();
+    camera.setTransform(viewTransform(create_point(0.0, 3.0, -6.0), create_point(0.0, 6.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    LightResampler resampler(*world, camera, std::make_shared<SobolSampler>());
+    
+    Canvas canvas(24, 16);
+    resampler.render(canvas);
+    EXPECT_EQ(canvas.pixelAt(12, 8), Colour(0.0, 0.0, 0.0));
+    EXPECT_EQ(resampler.reservoirAt(12, 8).light, LightResampler::noLight);
+}
+
+}
@@ -143,4 +143,52 @@ TEST(ObjectTest, NormalTransformedShape) {
     EXPECT_EQ(normal, create_vector(0.0, 0.97014, -0.24254));
 }
 
+TEST(ObjectTest, MotionInterpolatesTransform) {
+    ObjectMock object;
+    auto version = object.transformVersion();
+    object.setMotion(translation(0.0, 0.0, 0.0), translation(4.0, 0.0, 0.0) * rotation_y(std::numbers::pi / 2.0));
+    
+    EXPECT_TRUE(object.isMoving());
+    EXPECT_GT(object.transformVersion(), version);
+    EXPECT_EQ(object.transform(), Matrix4x4::identityMatrix());
+    EXPECT_EQ(object.transformAt(0.5), translation(2.0, 0.0, 0.0) * rotation_y(std::numbers::pi / 4.0));
+    EXPECT_EQ(object.transformAt(2.0), object.endTransform());
+    
+    object.setTransform(translation(1.0, 0.0, 0.0));
+    EXPECT_FALSE(object.isMoving());
+    EXPECT_EQ(object.transformAt(0.5), translation(1.0, 0.0, 0.0));
+}
+
+TEST(ObjectTest, IntersectMovingShapeAtRayTime) {
+    ObjectMock object;
+    object.setMotion(translation(0.0, 0.0, 0.0), translation(4.0, 0.0, 0.0));
+    
+    object.intersects(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 0.5));
+    EXPECT_EQ(_lastRay.origin(), create_point(-2.0, 0.0, -5.0));
+    EXPECT_EQ(_lastRay.time(), 0.5);
+    
+    Intersect hit(&object, 1.0, 0, 1.0);
+    EXPECT_EQ(object.normalAt(create_point(4.0, 1.0, 0.0), hit), create_vector(0.0, 1.0, 0.0));
+}
+
+TEST(ObjectTest, MovingBoundsCoverTheMotion) {
+    class BoxMock : public ObjectMock {
+    public:
+        virtual BoundingBox localBounds() const {
+            return BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0));
+        }
+    };
+    
+    BoxMock object;
+    object.setMotion(translation(0.0, 0.0, 0.0), translation(4.0, 0.0, 0.0) * rotation_z(std::numbers::pi / 2.0));
+    auto bounds = object.bounds();
+    
+    for (unsigned int step = 0; step <= 100; step++) {
+        auto transform = object.transformAt(step / 100.0);
+        for (auto corner : {create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0), create_point(1.0, -1.0, 1.0), create_point(-1.0, 1.0, -1.0)}) {
+            EXPECT_TRUE(bounds.contains(transform * corner)) << step;
+        }
+    }
+}
+
 }
@@ -0,0 +1,155 @@
+//
+//  path_integrator_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "camera.hpp"
+#include "lighting.hpp"
+#include "path_integrator.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+TEST(PathIntegratorTest, RayMissIsBlack) {
+    auto world = World::defaultWorld();
+    PathIntegrator integrator(*world);
+    EXPECT_EQ(integrator.colourAt(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 1.0, 0.0))), Colour(0.0, 0.0, 0.0));
+}
+
+TEST(PathIntegratorTest, EmissiveSurfaceSeenDirectly) {
+    World world;
+    auto sphere = std::make_unique<Sphere>();
+    sphere->material()._emissive = Colour(1.0, 0.5, 0.25);
+    sphere->material()._diffuse = 0.0;
+    sphere->material()._specular = 0.0;
+    world.addObject(std::move(sphere));
+    
+    PathIntegrator integrator(world);
+    EXPECT_EQ(integrator.colourAt(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0))), Colour(1.0, 0.5, 0.25));
+}
+
+TEST(PathIntegratorTest, DirectLightingMatchesLambertTerm) {
+    //nothing for the bounce to hit, so the only light is the deterministic light sample
+    World world;
+    world.addLight(std::make_unique<Light>(create_point(0.0, 10.0, 0.0), Colour(1.0, 1.0, 1.0)));
+    auto floor = std::make_unique<Plane>();
+    floor->material()._colour = Colour(1.0, 0.5, 0.0);
+    floor->material()._specular = 0.0;
+    world.addObject(std::move(floor));
+    
+    PathIntegrator integrator(world);
+    auto colour = integrator.colourAt(Ray(create_point(0.0, 1.0, 0.0), create_vector(0.0, -1.0, 0.0)));
+    EXPECT_EQ(colour, Colour(0.9, 0.45, 0.0));
+}
+
+TEST(PathIntegratorTest, ShadowedPointGetsNoDirectLight) {
+    World world;
+    world.addLight(std::make_unique<Light>(create_point(0.0, 10.0, 0.0), Colour(1.0, 1.0, 1.0)));
+    world.addObject(std::make_unique<Plane>());
+    auto blocker = std::make_unique<Sphere>();
+    blocker->setTransform(translation(0.0, 5.0, 0.0));
+    blocker->material()._diffuse = 0.0;
+    blocker->material()._specular = 0.0;
+    world.addObject(std::move(blocker));
+    
+    PathIntegrator integrator(world);
+    EXPECT_EQ(integrator.colourAt(Ray(create_point(0.5, 1.0, 0.0), create_vector(0.0, -1.0, 0.0))), Colour(0.0, 0.0, 0.0));
+}
+
+TEST(PathIntegratorTest, FurnaceConvergesToGeometricSeries) {
+    //inside a sphere glowing E with albedo a every path bounces forever, giving E / (1 - a)
+    World world;
+    auto sphere = std::make_unique<Sphere>();
+    sphere->material()._emissive = Colour(0.5, 0.5, 0.5);
+    sphere->material()._diffuse = 0.5;
+    sphere->material()._specular = 0.0;
+    world.addObject(std::move(sphere));
+    
+    PathIntegrator integrator(world, 64);
+    const unsigned int samples = 4000;
+    double sum = 0.0;
+    for (unsigned int i = 0; i < samples; i++) {
+        sum += integrator.colourAt(Ray(create_point(0.0, 0.0, 0.0), create_vector(0.0, 0.0, 1.0))).red();
+    }
+    
+    EXPECT_NEAR(sum / samples, 1.0, 0.03);
+}
+
+TEST(PathIntegratorTest, AccumulatesProgressively) {
+    auto world = World::defaultWorld();
+    PathIntegrator integrator(*world);
+    Camera camera(4, 3, std::numbers::pi / 2.0);
+    camera.setTransform(viewTransform(create_point(0.0, 0.0, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    
+    AccumulationBuffer buffer(4, 3);
+    integrator.accumulate(camera, buffer);
+    integrator.accumulate(camera, buffer, 3);
+    integrator.accumulate(camera, buffer, 2, 1, 2);
+    
+    EXPECT_EQ(buffer.sampleCount(0, 0), 4);
+    EXPECT_EQ(buffer.sampleCount(3, 1), 6);
+    EXPECT_EQ(buffer.sampleCount(2, 2), 4);
+}
+
+TEST(PathIntegratorTest, SamplerMakesPassesRepeatable) {
+    auto world = World::defaultWorld();
+    Camera camera(4, 3, std::numbers::pi / 2.0);
+    camera.setTransform(viewTransform(create_point(0.0, 0.0, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    auto sampler = std::make_shared<SobolSampler>();
+    
+    AccumulationBuffer first(4, 3);
+    PathIntegrator a(*world, 8, 1);
+    a.setSampler(sampler);
+    a.accumulate(camera, first, 4);
+    
+    //a different seed for the fallback generator changes nothing when the sampler drives the path
+    AccumulationBuffer second(4, 3);
+    PathIntegrator b(*world, 8, 99);
+    b.setSampler(sampler);
+    b.accumulate(camera, second, 2);
+    b.accumulate(camera, second, 2);
+    
+    for (unsigned int y = 0; y < 3; y++) {
+        for (unsigned int x = 0; x < 4; x++) {
+            EXPECT_EQ(first.average(x, y), second.average(x, y));
+        }
+    }
+}
+
+TEST(PathIntegratorTest, LightBVHMatchesShadingEveryLight) {
+    World world;
+    for (int i = 0; i < 6; i++) {
+        world.addLight(std::make_unique<Light>(create_point(i * 3.0 - 7.5, 10.0, i - 2.5), Colour(0.1, 0.2, 0.1) * (1.0 + i)));
+    }
+    auto floor = std::make_unique<Plane>();
+    floor->material()._specular = 0.0;
+    floor->material()._diffuse = 0.5;
+    world.addObject(std::move(floor));
+    
+    const Ray ray(create_point(0.0, 1.0, 0.0), create_vector(0.0, -1.0, 0.0));
+    auto expected = PathIntegrator(world).colourAt(ray);
+    
+    world.buildLightBVH();
+    ASSERT_NE(world.lightBvh(), nullptr);
+    PathIntegrator integrator(world);
+    const unsigned int samples = 4000;
+    Colour sum;
+    for (unsigned int i = 0; i < samples; i++) {
+        sum = sum + integrator.colourAt(ray);
+    }
+    
+    EXPECT_NEAR(sum.green() / samples, expected.green(), 0.02 * expected.green());
+}
+
+}
@@ -65,4 +65,15 @@ TEST(RayTest, ScaleRay) {
     EXPECT_EQ(transformedRay.direction(), create_vector(0.0, 3.0, 0.0));
 }
 
+TEST(RayTest, TimeDefaultsToZeroAndSurvivesTransform) {
+    Ray r(create_point(1.0, 2.0, 3.0), create_vector(0.0, 1.0, 0.0));
+    EXPECT_EQ(r.time(), 0.0);
+    
+    Ray timed(create_point(1.0, 2.0, 3.0), create_vector(0.0, 1.0, 0.0), 0.25);
+    EXPECT_EQ(timed.transform(rtlib::scaling(2.0, 3.0, 4.0)).time(), 0.25);
+    
+    timed.setTime(0.75);
+    EXPECT_EQ(timed.time(), 0.75);
+}
+
 }
@@ -0,0 +1,110 @@
+//
+//  region_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "region.hpp"
+
+#include "integrator.hpp"
+#include "path_integrator.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+
+using namespace rtlib;
+
+namespace {
+
+Camera testCamera() {
+    Camera camera(16, 12, std::numbers::pi / 3.0);
+    camera.setTransform(viewTransform(create_point(0.0, 1.5, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    return camera;
+}
+
+TEST(RegionTest, ClipRectToCanvas) {
+    auto rect = PixelRect{12, 8, 10, 10}.clipped(16, 12);
+    EXPECT_EQ(rect.x, 12);
+    EXPECT_EQ(rect.y, 8);
+    EXPECT_EQ(rect.width, 4);
+    EXPECT_EQ(rect.height, 4);
+    
+    EXPECT_EQ(PixelRect({20, 2, 3, 3}).clipped(16, 12).area(), 0);
+}
+
+TEST(RegionTest, OverlappingRectsCoveredOnce) {
+    auto spans = coveredSpans({{2, 1, 4, 2}, {4, 2, 4, 2}, {12, 2, 10, 1}}, 16, 12);
+    
+    ASSERT_EQ(spans.size(), 4);
+    EXPECT_EQ(spans[0].y, 1);
+    EXPECT_EQ(spans[0].xStart, 2);
+    EXPECT_EQ(spans[0].xEnd, 6);
+    
+    //the first two merge where they overlap, the third is clipped at the canvas edge
+    EXPECT_EQ(spans[1].y, 2);
+    EXPECT_EQ(spans[1].xStart, 2);
+    EXPECT_EQ(spans[1].xEnd, 8);
+    EXPECT_EQ(spans[2].y, 2);
+    EXPECT_EQ(spans[2].xStart, 12);
+    EXPECT_EQ(spans[2].xEnd, 16);
+    
+    EXPECT_EQ(spans[3].y, 3);
+    EXPECT_EQ(spans[3].xStart, 4);
+    EXPECT_EQ(spans[3].xEnd, 8);
+}
+
+TEST(RegionTest, RegionMatchesFullFrame) {
+    auto world = World::defaultWorld();
+    auto camera = testCamera();
+    Integrator integrator(*world);
+    auto trace = [&](const Ray& ray) { return integrator.colourAt(ray); };
+    
+    Canvas full(16, 12);
+    RegionRenderer renderer(camera);
+    renderer.render(full, PixelRect{0, 0, 16, 12}, trace);
+    
+    //a canvas of a different colour with two regions patched in
+    Canvas patched(16, 12);
+    for (unsigned int y = 0; y < 12; y++) {
+        for (unsigned int x = 0; x < 16; x++) {
+            patched.writePixel(x, y, Colour(1.0, 0.0, 1.0));
+        }
+    }
+    
+    auto rendered = renderer.render(patched, {{3, 2, 6, 5}, {7, 5, 4, 4}}, trace);
+    EXPECT_EQ(rendered, 30 + 16 - 4);
+    
+    for (unsigned int y = 0; y < 12; y++) {
+        for (unsigned int x = 0; x < 16; x++) {
+            auto inside = (x >= 3 && x < 9 && y >= 2 && y < 7) || (x >= 7 && x < 11 && y >= 5 && y < 9);
+            EXPECT_EQ(patched.pixelAt(x, y), inside ? full.pixelAt(x, y) : Colour(1.0, 0.0, 1.0)) << x << ", " << y;
+        }
+    }
+    
+    Canvas wrongSize(8, 8);
+    EXPECT_THROW(renderer.render(wrongSize, PixelRect{0, 0, 4, 4}, trace), std::invalid_argument);
+}
+
+TEST(RegionTest, PathTracedRegionMatchesFullFrame) {
+    auto world = World::defaultWorld();
+    auto camera = testCamera();
+    auto sampler = std::make_shared<SobolSampler>();
+    
+    PathIntegrator integrator(*world);
+    integrator.setSampler(sampler);
+    AccumulationBuffer full(16, 12);
+    integrator.accumulate(camera, full, 2);
+    
+    AccumulationBuffer region(16, 12);
+    integrator.accumulate(camera, region, 2, coveredSpans({{5, 4, 3, 3}}, 16, 12));
+    
+    EXPECT_EQ(region.sampleCount(0, 0), 0);
+    EXPECT_EQ(region.sampleCount(5, 4), 2);
+    EXPECT_EQ(region.average(6, 5), full.average(6, 5));
+}
+
+}
@@ -0,0 +1,127 @@
+//
+//  sampler_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "sampler.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+
+using namespace rtlib;
+
+namespace {
+
+std::vector<std::unique_ptr<Sampler>> allSamplers() {
+    std::vector<std::unique_ptr<Sampler>> samplers;
+    samplers.push_back(std::make_unique<SobolSampler>(7));
+    samplers.push_back(std::make_unique<BlueNoiseSampler>(16, 7));
+    samplers.push_back(std::make_unique<StratifiedSampler>(16, 7));
+    return samplers;
+}
+
+TEST(SamplerTest, DeterministicAndInRange) {
+    for (const auto& sampler : allSamplers()) {
+        for (unsigned int dimension = 0; dimension < 10; dimension++) {
+            for (unsigned int index = 0; index < 64; index++) {
+                auto value = sampler->sample(3, 5, index, dimension);
+                EXPECT_GE(value, 0.0);
+                EXPECT_LT(value, 1.0);
+                EXPECT_EQ(value, sampler->sample(3, 5, index, dimension));
+            }
+        }
+        
+        auto pair = sampler->sample2D(3, 5, 2, 4);
+        EXPECT_EQ(pair[0], sampler->sample(3, 5, 2, 4));
+        EXPECT_EQ(pair[1], sampler->sample(3, 5, 2, 5));
+    }
+}
+
+TEST(SamplerTest, PixelsAreDecorrelated) {
+    for (const auto& sampler : allSamplers()) {
+        EXPECT_NE(sampler->sample(0, 0, 0, 0), sampler->sample(1, 0, 0, 0));
+        EXPECT_NE(sampler->sample(0, 0, 0, 0), sampler->sample(0, 1, 0, 0));
+        EXPECT_NE(sampler->sample(0, 0, 0, 0), sampler->sample(0, 0, 0, 1));
+    }
+}
+
+//the first 2^k points of a scrambled sobol sequence land one per interval of width 2^-k
+TEST(SamplerTest, SobolIsStratifiedInEveryDimension) {
+    SobolSampler sampler(3);
+    const unsigned int count = 64;
+    
+    for (unsigned int dimension = 0; dimension < 9; dimension++) {
+        std::set<unsigned int> intervals;
+        for (unsigned int index = 0; index < count; index++) {
+            intervals.insert(static_cast<unsigned int>(sampler.sample(2, 9, index, dimension) * count));
+        }
+        EXPECT_EQ(intervals.size(), count) << "dimension " << dimension;
+    }
+}
+
+TEST(SamplerTest, SobolPairsAreStratifiedIn2D) {
+    //dimensions 0 and 1 of a sobol sequence form (0, 2) sequence, 16 points fill a 4x4 grid
+    SobolSampler sampler(11);
+    std::set<std::pair<unsigned int, unsigned int>> cells;
+    for (unsigned int index = 0; index < 16; index++) {
+        auto point = sampler.sample2D(4, 4, index, 0);
+        cells.insert({static_cast<unsigned int>(point[0] * 4), static_cast<unsigned int>(point[1] * 4)});
+    }
+    EXPECT_EQ(cells.size(), 16);
+}
+
+TEST(SamplerTest, StratifiedCoversEveryStratum) {
+    StratifiedSampler sampler(10);
+    EXPECT_EQ(sampler.samplesPerPixel(), 10);
+    
+    for (unsigned int round = 0; round < 3; round++) {
+        for (unsigned int dimension = 0; dimension < 4; dimension++) {
+            std::set<unsigned int> strata;
+            for (unsigned int index = round * 10; index < (round + 1) * 10; index++) {
+                strata.insert(static_cast<unsigned int>(sampler.sample(1, 2, index, dimension) * 10));
+            }
+            EXPECT_EQ(strata.size(), 10);
+        }
+    }
+}
+
+TEST(SamplerTest, BlueNoiseTileHoldsEveryRankOnce) {
+    BlueNoiseSampler sampler(16);
+    EXPECT_EQ(sampler.tileSize(), 16);
+    
+    std::vector<uint32_t> ranks;
+    for (unsigned int y = 0; y < 16; y++) {
+        for (unsigned int x = 0; x < 16; x++) {
+            ranks.push_back(sampler.rankAt(x, y));
+        }
+    }
+    
+    std::sort(ranks.begin(), ranks.end());
+    for (uint32_t i = 0; i < ranks.size(); i++) {
+        EXPECT_EQ(ranks[i], i);
+    }
+    
+    EXPECT_EQ(sampler.rankAt(3, 4), sampler.rankAt(19, 36));
+}
+
+TEST(SamplerTest, BlueNoiseSpreadsLowRanks) {
+    //the first quarter of the ranks should never sit next to each other
+    BlueNoiseSampler sampler(16);
+    for (unsigned int y = 0; y < 16; y++) {
+        for (unsigned int x = 0; x < 16; x++) {
+            if (sampler.rankAt(x, y) >= 64) {
+                continue;
+            }
+            
+            EXPECT_GE(sampler.rankAt(x + 1, y), 64);
+            EXPECT_GE(sampler.rankAt(x, y + 1), 64);
+        }
+    }
+}
+
+}
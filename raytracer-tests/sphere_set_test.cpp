@@ -0,0 +1,233 @@
+//
+//  sphere_set_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "sphere.hpp"
+#include "sphere_set.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace rtlib;
+
+namespace {
+
+struct SphereDesc {
+    Tuple centre;
+    double radius;
+};
+
+std::vector<SphereDesc> sphereField() {
+    std::vector<SphereDesc> spheres;
+    for (unsigned int i = 0; i < 61; i++) {
+        //a fixed stride coprime with the count scatters the spheres deterministically
+        auto j = (i * 37) % 61;
+        spheres.push_back({create_point((j % 7) * 2.5 - 7.5, (j / 7) * 2.5 - 10.0, (i % 5) * 3.0), 0.4 + (i % 4) * 0.2});
+    }
+    return spheres;
+}
+
+std::vector<Ray> raysTowards(const std::vector<SphereDesc>& spheres) {
+    std::vector<Ray> rays;
+    auto origin = create_point(0.3, 0.2, -20.0);
+    for (const auto& sphere : spheres) {
+        rays.push_back(Ray(origin, (sphere.centre - origin).normalised()));
+        rays.push_back(Ray(origin, (sphere.centre + create_vector(sphere.radius * 0.9, 0.0, 0.0) - origin).normalised()));
+    }
+    rays.push_back(Ray(origin, create_vector(0.0, 1.0, 0.0)));
+    return rays;
+}
+
+std::vector<std::pair<double, unsigned int>> sortedHits(const SphereSet& set, const Ray& ray) {
+    std::vector<std::pair<double, unsigned int>> hits;
+    for (const auto& hit : set.intersects(ray)) {
+        hits.push_back({hit.t, set.sphereIndex(hit)});
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+TEST(SphereSetTest, MatchesIndividualSpheres) {
+    auto spheres = sphereField();
+    SphereSet set;
+    std::vector<std::unique_ptr<Sphere>> objects;
+    for (const auto& sphere : spheres) {
+        set.addSphere(sphere.centre, sphere.radius);
+        
+        auto object = std::make_unique<Sphere>();
+        object->setTransform(translation(sphere.centre.x(), sphere.centre.y(), sphere.centre.z()) *
+                             scaling(sphere.radius, sphere.radius, sphere.radius));
+        objects.push_back(std::move(object));
+    }
+    set.build(8);
+    
+    for (const auto& ray : raysTowards(spheres)) {
+        std::vector<std::pair<double, unsigned int>> expected;
+        for (unsigned int i = 0; i < objects.size(); i++) {
+            for (const auto& hit : objects[i]->intersects(ray)) {
+                expected.push_back({hit.t, i});
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        
+        auto hits = sortedHits(set, ray);
+        ASSERT_EQ(hits.size(), expected.size());
+        for (unsigned int h = 0; h < hits.size(); h++) {
+            EXPECT_NEAR(hits[h].first, expected[h].first, 1e-9);
+            EXPECT_EQ(hits[h].second, expected[h].second);
+        }
+    }
+}
+
+TEST(SphereSetTest, BuildDoesNotChangeHits) {
+    auto spheres = sphereField();
+    SphereSet unbuilt;
+    SphereSet built;
+    for (const auto& sphere : spheres) {
+        unbuilt.addSphere(sphere.centre, sphere.radius);
+        built.addSphere(sphere.centre, sphere.radius);
+    }
+    built.build(6);
+    
+    EXPECT_EQ(unbuilt.bvh(), nullptr);
+    ASSERT_NE(built.bvh(), nullptr);
+    
+    for (const auto& ray : raysTowards(spheres)) {
+        EXPECT_EQ(sortedHits(unbuilt, ray), sortedHits(built, ray));
+    }
+}
+
+TEST(SphereSetTest, PaddingLanesNeverHit) {
+    //the unused lanes hold zero radius spheres at the origin, which this ray passes through
+    SphereSet set;
+    for (unsigned int i = 0; i < 5; i++) {
+        set.addSphere(create_point(i * 3.0 + 10.0, 0.0, 0.0), 1.0);
+    }
+    
+    auto ray = Ray(create_point(0.0, -5.0, 0.0), create_vector(0.0, 1.0, 0.0));
+    EXPECT_TRUE(set.intersects(ray).empty());
+    
+    set.build(8);
+    EXPECT_TRUE(set.intersects(ray).empty());
+}
+
+TEST(SphereSetTest, NormalsAndMaterialsPerSphere) {
+    SphereSet set;
+    set.setTransform(translation(0.0, 1.0, 0.0));
+    
+    Material red;
+    red._colour = Colour(1.0, 0.0, 0.0);
+    auto redIndex = set.addMaterial(red);
+    set.addSphere(create_point(-2.0, 0.0, 0.0), 1.0, redIndex);
+    set.addSphere(create_point(2.0, 0.0, 0.0), 0.5);
+    set.material()._colour = Colour(0.0, 0.0, 1.0);
+    set.build();
+    
+    auto hits = set.intersects(Ray(create_point(-2.0, 1.0, -5.0), create_vector(0.0, 0.0, 1.0)));
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(set.sphereIndex(hits[0]), 0);
+    EXPECT_EQ(set.materialAt(hits[0])._colour, Colour(1.0, 0.0, 0.0));
+    EXPECT_EQ(set.normalAt(create_point(-2.0, 2.0, 0.0), hits[0]), create_vector(0.0, 1.0, 0.0));
+    
+    hits = set.intersects(Ray(create_point(2.0, 1.0, -5.0), create_vector(0.0, 0.0, 1.0)));
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(set.sphereIndex(hits[0]), 1);
+    EXPECT_EQ(set.materialAt(hits[0])._colour, Colour(0.0, 0.0, 1.0));
+    EXPECT_EQ(set.normalAt(create_point(2.5, 1.0, 0.0), hits[0]), create_vector(1.0, 0.0, 0.0));
+}
+
+TEST(SphereSetTest, RendersLikeSeparateSpheres) {
+    auto spheres = sphereField();
+    
+    World separate;
+    World combined;
+    for (auto world : {&separate, &combined}) {
+        world->addLight(std::make_unique<Light>(create_point(-10.0, 10.0, -30.0), Colour(1.0, 1.0, 1.0)));
+    }
+    
+    auto set = std::make_unique<SphereSet>();
+    for (const auto& sphere : spheres) {
+        set->addSphere(sphere.centre, sphere.radius);
+        
+        auto object = std::make_unique<Sphere>();
+        object->setTransform(translation(sphere.centre.x(), sphere.centre.y(), sphere.centre.z()) *
+                             scaling(sphere.radius, sphere.radius, sphere.radius));
+        separate.addObject(std::move(object));
+    }
+    set->build();
+    combined.addObject(std::move(set));
+    combined.buildBVH();
+    combined.compile();
+    
+    for (const auto& ray : raysTowards(spheres)) {
+        auto expected = separate.colourAt(ray);
+        auto colour = combined.colourAt(ray);
+        EXPECT_NEAR(colour.red(), expected.red(), 1e-6);
+        EXPECT_NEAR(colour.green(), expected.green(), 1e-6);
+        EXPECT_NEAR(colour.blue(), expected.blue(), 1e-6);
+    }
+}
+
+TEST(SphereSetTest, WorldBVHHoldsSetLeaves) {
+    auto spheres = sphereField();
+    auto set = std::make_unique<SphereSet>();
+    for (const auto& sphere : spheres) {
+        set->addSphere(sphere.centre, sphere.radius);
+    }
+    set->build(4);
+    
+    auto ranges = set->primitiveRanges();
+    ASSERT_GT(ranges.size(), 1);
+    unsigned int covered = 0;
+    for (const auto& range : ranges) {
+        covered += range.count;
+    }
+    EXPECT_EQ(covered, spheres.size());
+    
+    World world;
+    auto* setPtr = set.get();
+    world.addObject(std::move(set));
+    world.buildBVH();
+    EXPECT_EQ(world.bvh()->primitives().size(), ranges.size());
+    
+    //moving the set refits its leaves in the world tree
+    setPtr->setTransform(translation(100.0, 0.0, 0.0));
+    world.updateBVH();
+    for (const auto& ray : raysTowards(spheres)) {
+        auto moved = Ray(ray.origin() + create_vector(100.0, 0.0, 0.0), ray.direction());
+        auto hits = world.intersects(moved);
+        auto expected = setPtr->intersects(moved);
+        EXPECT_EQ(hits.size(), expected.size());
+    }
+}
+
+TEST(SphereSetTest, WorldBVHRebuildsAfterSetChanges) {
+    auto set = std::make_unique<SphereSet>();
+    for (unsigned int i = 0; i < 20; i++) {
+        set->addSphere(create_point(i * 2.0, 0.0, 0.0), 0.5);
+    }
+    set->build(2);
+    
+    World world;
+    auto* setPtr = set.get();
+    world.addObject(std::move(set));
+    world.buildBVH();
+    
+    setPtr->addSphere(create_point(0.0, 5.0, 0.0), 0.5);
+    EXPECT_THROW(world.intersects(Ray(create_point(0.0, 5.0, -5.0), create_vector(0.0, 0.0, 1.0))), std::logic_error);
+    
+    setPtr->build(2);
+    world.updateBVH();
+    EXPECT_EQ(world.intersects(Ray(create_point(0.0, 5.0, -5.0), create_vector(0.0, 0.0, 1.0))).size(), 2);
+    EXPECT_EQ(world.intersects(Ray(create_point(30.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0))).size(), 2);
+    EXPECT_EQ(world.bvh()->primitives().size(), setPtr->primitiveRanges().size());
+}
+
+}
@@ -222,4 +222,24 @@ TEST(TransformationTest, ArbitraryViewTransformation) {
     EXPECT_EQ(viewTransform, result);
 }
 
+TEST(TransformationTest, DecomposeRecomposes) {
+    auto transform = rtlib::translation(1.0, -2.0, 3.0) * rtlib::rotation_z(0.7) * rtlib::rotation_x(-0.3) * rtlib::scaling(1.0, 2.0, 3.0);
+    auto parts = rtlib::decompose(transform);
+    
+    EXPECT_EQ(parts.translation, rtlib::create_vector(1.0, -2.0, 3.0));
+    EXPECT_EQ(rtlib::interpolate(parts, parts, 0.4), transform);
+    
+    auto mirrored = rtlib::scaling(-1.0, 1.0, 1.0) * rtlib::rotation_y(0.5);
+    auto mirroredParts = rtlib::decompose(mirrored);
+    EXPECT_EQ(rtlib::interpolate(mirroredParts, mirroredParts, 0.0), mirrored);
+}
+
+TEST(TransformationTest, InterpolateRotatesRigidly) {
+    auto start = rtlib::decompose(rtlib::translation(0.0, 0.0, 0.0) * rtlib::scaling(2.0, 2.0, 2.0));
+    auto end = rtlib::decompose(rtlib::translation(4.0, 0.0, 0.0) * rtlib::rotation_y(std::numbers::pi / 2.0) * rtlib::scaling(2.0, 2.0, 2.0));
+    
+    EXPECT_EQ(rtlib::interpolate(start, end, 0.5), rtlib::translation(2.0, 0.0, 0.0) * rtlib::rotation_y(std::numbers::pi / 4.0) * rtlib::scaling(2.0, 2.0, 2.0));
+    EXPECT_NEAR(rtlib::rotationAngle(start, end), std::numbers::pi / 2.0, 1e-9);
+}
+
 }
@@ -0,0 +1,186 @@
+//
+//  wavefront_integrator_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "wavefront_integrator.hpp"
+
+#include "lighting.hpp"
+#include "path_integrator.hpp"
+#include "plane.hpp"
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "world.hpp"
+
+#include <numbers>
+#include <thread>
+
+using namespace rtlib;
+
+namespace {
+
+Camera testCamera() {
+    Camera camera(8, 6, std::numbers::pi / 2.0);
+    camera.setTransform(viewTransform(create_point(0.0, 1.0, -5.0), create_point(0.0, 0.0, 0.0), create_vector(0.0, 1.0, 0.0)));
+    return camera;
+}
+
+std::unique_ptr<World> mixedWorld() {
+    auto world = World::defaultWorld();
+    
+    auto floor = std::make_unique<Plane>();
+    floor->setTransform(translation(0.0, -1.0, 0.0));
+    floor->material()._reflective = 0.3;
+    world->addObject(std::move(floor));
+    
+    auto glass = std::make_unique<Sphere>();
+    glass->setTransform(translation(1.5, 0.0, -1.0) * scaling(0.75, 0.75, 0.75));
+    glass->material()._reflective = 0.9;
+    glass->material()._transparency = 0.9;
+    glass->material()._refractiveIndex = 1.5;
+    glass->material()._emissive = Colour(0.1, 0.0, 0.2);
+    world->addObject(std::move(glass));
+    
+    return world;
+}
+
+void expectSameImage(const AccumulationBuffer& a, const AccumulationBuffer& b) {
+    for (unsigned int y = 0; y < a.height(); y++) {
+        for (unsigned int x = 0; x < a.width(); x++) {
+            EXPECT_EQ(a.sampleCount(x, y), b.sampleCount(x, y));
+            EXPECT_EQ(a.average(x, y), b.average(x, y)) << x << ", " << y;
+        }
+    }
+}
+
+TEST(WavefrontIntegratorTest, MatchesPathIntegratorWithSampler) {
+    auto world = mixedWorld();
+    auto camera = testCamera();
+    auto sampler = std::make_shared<SobolSampler>();
+    
+    AccumulationBuffer expected(camera.horizontalSize(), camera.verticalSize());
+    PathIntegrator paths(*world);
+    paths.setSampler(sampler);
+    paths.accumulate(camera, expected, 4);
+    
+    AccumulationBuffer buffer(camera.horizontalSize(), camera.verticalSize());
+    WavefrontIntegrator wavefront(*world);
+    wavefront.setSampler(sampler);
+    wavefront.accumulate(camera, buffer, 4);
+    
+    expectSameImage(expected, buffer);
+}
+
+TEST(WavefrontIntegratorTest, MatchesPathIntegratorThroughLens) {
+    auto world = mixedWorld();
+    auto camera = testCamera();
+    camera.setLens(0.3, 5.0);
+    auto sampler = std::make_shared<StratifiedSampler>(4);
+    
+    AccumulationBuffer expected(camera.horizontalSize(), camera.verticalSize());
+    PathIntegrator paths(*world);
+    paths.setSampler(sampler);
+    paths.accumulate(camera, expected, 4);
+    
+    AccumulationBuffer buffer(camera.horizontalSize(), camera.verticalSize());
+    WavefrontIntegrator wavefront(*world);
+    wavefront.setSampler(sampler);
+    wavefront.accumulate(camera, buffer, 4);
+    
+    expectSameImage(expected, buffer);
+}
+
+TEST(WavefrontIntegratorTest, MatchesPathIntegratorWithMotionBlur) {
+    auto world = mixedWorld();
+    world->objects().front()->setMotion(Matrix4x4::identityMatrix(), translation(0.0, 1.0, 0.0) * rotation_y(1.0));
+    auto camera = testCamera();
+    camera.setShutter(0.0, 1.0);
+    auto sampler = std::make_shared<SobolSampler>();
+    
+    AccumulationBuffer expected(camera.horizontalSize(), camera.verticalSize());
+    PathIntegrator paths(*world);
+    paths.setSampler(sampler);
+    paths.accumulate(camera, expected, 4);
+    
+    AccumulationBuffer buffer(camera.horizontalSize(), camera.verticalSize());
+    WavefrontIntegrator wavefront(*world);
+    wavefront.setSampler(sampler);
+    wavefront.accumulate(camera, buffer, 4);
+    
+    expectSameImage(expected, buffer);
+}
+
+TEST(WavefrontIntegratorTest, MatchesPathIntegratorWithLightBVH) {
+    auto world = mixedWorld();
+    world->addLight(std::make_unique<Light>(create_point(5.0, 10.0, -5.0), Colour(0.3, 0.3, 0.6)));
+    world->buildLightBVH();
+    auto camera = testCamera();
+    auto sampler = std::make_shared<SobolSampler>();
+    
+    AccumulationBuffer expected(camera.horizontalSize(), camera.verticalSize());
+    PathIntegrator paths(*world);
+    paths.setSampler(sampler);
+    paths.accumulate(camera, expected, 2);
+    
+    AccumulationBuffer buffer(camera.horizontalSize(), camera.verticalSize());
+    WavefrontIntegrator wavefront(*world);
+    wavefront.setSampler(sampler);
+    wavefront.accumulate(camera, buffer, 2);
+    
+    expectSameImage(expected, buffer);
+}
+
+TEST(WavefrontIntegratorTest, ThreadedStagesGiveSameImage) {
+    auto world = mixedWorld();
+    auto camera = testCamera();
+    
+    AccumulationBuffer serial(camera.horizontalSize(), camera.verticalSize());
+    WavefrontIntegrator(*world, 8, 7).accumulate(camera, serial, 3);
+    
+    //four threads each taking every fourth block of five, so queue slots are claimed out of order
+    WavefrontIntegrator threaded(*world, 8, 7);
+    threaded.setParallelFor([](unsigned int size, const WavefrontIntegrator::Kernel& kernel) {
+        std::vector<std::thread> threads;
+        for (unsigned int t = 0; t < 4; t++) {
+            threads.emplace_back([&, t]() {
+                for (unsigned int first = t * 5; first < size; first += 20) {
+                    kernel(first, std::min(first + 5, size));
+                }
+            });
+        }
+        
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+    
+    AccumulationBuffer parallel(camera.horizontalSize(), camera.verticalSize());
+    threaded.accumulate(camera, parallel, 3);
+    
+    expectSameImage(serial, parallel);
+}
+
+TEST(WavefrontIntegratorTest, StageTimingsCountRays) {
+    auto world = mixedWorld();
+    auto camera = testCamera();
+    auto pixels = camera.horizontalSize() * camera.verticalSize();
+    
+    WavefrontIntegrator integrator(*world);
+    AccumulationBuffer buffer(camera.horizontalSize(), camera.verticalSize());
+    integrator.accumulate(camera, buffer, 2);
+    
+    const auto& timings = integrator.timings();
+    EXPECT_GT(timings.extensionRays, 2 * pixels);
+    EXPECT_GT(timings.shadowRays, 0);
+    EXPECT_GT(timings.extend.count(), 0);
+    
+    integrator.resetTimings();
+    EXPECT_EQ(integrator.timings().extensionRays, 0);
+    EXPECT_EQ(integrator.timings().extend.count(), 0);
+}
+
+}
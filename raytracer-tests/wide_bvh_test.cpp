@@ -0,0 +1,155 @@
+//
+//  wide_bvh_test.cpp
+//  raytracer-tests
+//
+//  Created by Daniel Burke on 19/10/2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "sphere.hpp"
+#include "transformations.hpp"
+#include "wide_bvh.hpp"
+#include "world.hpp"
+
+#include <cmath>
+#include <limits>
+#include <set>
+
+using namespace rtlib;
+
+namespace {
+
+std::vector<BoundingBox> scatteredBoxes(unsigned int count) {
+    std::vector<BoundingBox> boxes;
+    for (unsigned int i = 0; i < count; i++) {
+        auto x = std::fmod(i * 7.31, 50.0) - 25.0;
+        auto y = std::fmod(i * 3.17, 20.0) - 10.0;
+        auto z = std::fmod(i * 5.53, 40.0);
+        auto size = 0.2 + std::fmod(i * 0.37, 1.0);
+        boxes.push_back(BoundingBox(create_point(x, y, z), create_point(x + size, y + size * 0.5, z + size)));
+    }
+    return boxes;
+}
+
+TEST(WideBVHTest, NodesHoldUpToEightChildren) {
+    BVH bvh(scatteredBoxes(500));
+    WideBVH wide(bvh);
+    
+    ASSERT_FALSE(wide.nodes().empty());
+    unsigned int leafPrimitives = 0;
+    for (const auto& node : wide.nodes()) {
+        EXPECT_GE(node.childCount, 1);
+        EXPECT_LE(node.childCount, WideBVH::width);
+        for (unsigned int i = 0; i < node.childCount; i++) {
+            leafPrimitives += node.leafCount[i];
+        }
+    }
+    
+    EXPECT_EQ(leafPrimitives, 500);
+    EXPECT_LT(wide.nodes().size(), bvh.nodes().size() / 4);
+}
+
+TEST(WideBVHTest, QuantisedNodesAreSmallerThanBinaryNodes) {
+    BVH bvh(scatteredBoxes(500));
+    WideBVH wide(bvh);
+    
+    auto binaryFootprint = bvh.nodes().size() * sizeof(BVH::Node);
+    EXPECT_LT(wide.memoryFootprint() * 2, binaryFootprint);
+}
+
+TEST(WideBVHTest, TraversalFindsEveryPrimitiveTheRayHits) {
+    auto boxes = scatteredBoxes(500);
+    BVH bvh(boxes);
+    WideBVH wide(bvh);
+    
+    for (unsigned int i = 0; i < 50; i++) {
+        Ray ray(create_point(-30.0 + i, 0.5 * i - 12.0, -10.0),
+                create_vector(0.3, 0.05 * (25.0 - i) / 25.0, 1.0).normalised());
+        
+        std::set<unsigned int> visited;
+        wide.traverse(ray, std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+            visited.insert(primitive);
+        });
+        
+        for (unsigned int p = 0; p < boxes.size(); p++) {
+            if (boxes[p].intersects(ray)) {
+                EXPECT_TRUE(visited.count(p)) << "ray " << i << " missed primitive " << p;
+            }
+        }
+    }
+}
+
+TEST(WideBVHTest, SinglePrimitiveHierarchy) {
+    BVH bvh({BoundingBox(create_point(-1.0, -1.0, -1.0), create_point(1.0, 1.0, 1.0))});
+    WideBVH wide(bvh);
+    
+    unsigned int visits = 0;
+    wide.traverse(Ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0)), std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        EXPECT_EQ(primitive, 0);
+        visits++;
+    });
+    EXPECT_EQ(visits, 1);
+    
+    wide.traverse(Ray(create_point(0.0, 3.0, -5.0), create_vector(0.0, 0.0, 1.0)), std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        visits++;
+    });
+    EXPECT_EQ(visits, 1);
+}
+
+TEST(WideBVHTest, VisitorCanEndTraversal) {
+    //a row of boxes down the z axis among the scattered ones
+    auto boxes = scatteredBoxes(500);
+    for (int i = 0; i < 40; i++) {
+        boxes.push_back(BoundingBox(create_point(-0.5, -0.5, i * 2.0), create_point(0.5, 0.5, i * 2.0 + 1.0)));
+    }
+    BVH bvh(boxes);
+    WideBVH wide(bvh);
+    Ray ray(create_point(0.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0));
+    
+    unsigned int primitives = 0;
+    auto allNodes = wide.traverse(ray, std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        primitives++;
+    });
+    EXPECT_GE(primitives, 40);
+    
+    //an any-hit query done with the first primitive skips the rest of the tree
+    primitives = 0;
+    auto someNodes = wide.traverse(ray, std::numeric_limits<double>::infinity(), [&](unsigned int primitive) {
+        primitives++;
+        return true;
+    });
+    EXPECT_EQ(primitives, 1);
+    EXPECT_LT(someNodes, allNodes);
+}
+
+TEST(WideBVHTest, WorldIntersectionsMatchWithWideHierarchy) {
+    auto w = World::defaultWorld();
+    for (unsigned int i = 0; i < 40; i++) {
+        auto s = std::make_unique<Sphere>();
+        s->setTransform(translation(i * 0.75 - 15.0, std::fmod(i * 0.37, 1.0), 3.0) * scaling(0.4, 0.4, 0.4));
+        w->addObject(std::move(s));
+    }
+    
+    std::vector<Ray> rays;
+    for (unsigned int i = 0; i < 40; i++) {
+        rays.push_back(Ray(create_point(i * 0.75 - 15.0, 0.3, -5.0), create_vector(0.0, 0.0, 1.0)));
+    }
+    
+    std::vector<Intersections> expected;
+    for (const auto& ray : rays) {
+        expected.push_back(w->intersects(ray));
+    }
+    
+    w->buildBVH(2, BVHLayout::Wide);
+    ASSERT_NE(w->wideBvh(), nullptr);
+    for (unsigned int i = 0; i < rays.size(); i++) {
+        auto hits = w->intersects(rays[i]);
+        ASSERT_EQ(hits.size(), expected[i].size());
+        for (unsigned int h = 0; h < hits.size(); h++) {
+            EXPECT_EQ(hits[h], expected[i][h]);
+        }
+    }
+}
+
+}
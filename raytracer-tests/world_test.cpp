@@ -16,7 +16,9 @@
 #include "transformations.hpp"
 #include "world.hpp"
 
+#include <cmath>
 #include <numbers>
+#include <thread>
 
 using namespace rtlib;
 
@@ -340,4 +342,92 @@ TEST(WorldTest, ShadeHitWithReflectiveTransparentMaterial) {
     EXPECT_EQ(colour, Colour(0.93391, 0.69643, 0.69243));
 }
 
+TEST(WorldTest, RepeatedShadowQueriesHitOccluderCache) {
+    auto world = World::defaultWorld();
+    world->buildBVH();
+    
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(world->isShadowed(create_point(10.0, -10.0, 10.0 + i * 0.01)));
+    }
+    
+    auto stats = world->occluderCacheStats();
+    EXPECT_EQ(stats.queries, 10);
+    EXPECT_EQ(stats.hits, 9);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.9);
+    
+    world->resetOccluderCacheStats();
+    EXPECT_EQ(world->occluderCacheStats().queries, 0);
+    EXPECT_EQ(world->occluderCacheStats().hitRate(), 0.0);
+}
+
+TEST(WorldTest, OccluderCacheStatsSumOverThreads) {
+    auto world = World::defaultWorld();
+    world->buildBVH();
+    
+    auto shade = [&world]() {
+        for (int i = 0; i < 10; i++) {
+            world->isShadowed(create_point(10.0, -10.0, 10.0 + i * 0.01));
+        }
+    };
+    
+    std::thread first(shade);
+    std::thread second(shade);
+    first.join();
+    second.join();
+    shade();
+    
+    //each thread misses its own cache once
+    auto stats = world->occluderCacheStats();
+    EXPECT_EQ(stats.queries, 30);
+    EXPECT_EQ(stats.hits, 27);
+}
+
+TEST(WorldTest, OccluderCacheMatchesUncachedQueries) {
+    auto world = World::defaultWorld();
+    const auto& light = *world->lights().front();
+    
+    std::vector<Tuple> points = {
+        create_point(10.0, -10.0, 10.0),
+        create_point(0.0, 10.0, 0.0),
+        create_point(10.0, -10.0, 10.0),
+        create_point(-20.0, 20.0, -20.0),
+        create_point(5.0, -5.0, 5.0),
+        create_point(-2.0, 2.0, -2.0),
+    };
+    
+    for (const auto& point : points) {
+        EXPECT_EQ(world->isOccluded(point, light.origin(), light), world->isOccluded(point, light.origin()));
+    }
+    
+    world->setOccluderCacheEnabled(false);
+    EXPECT_TRUE(world->isOccluded(points[0], light.origin(), light));
+    EXPECT_EQ(world->occluderCacheStats().queries, points.size());
+}
+
+TEST(WorldTest, MovingSphereHitWhereItIsAtRayTime) {
+    for (bool accelerated : {false, true}) {
+        World world;
+        auto sphere = std::make_unique<Sphere>();
+        sphere->setMotion(translation(0.0, 0.0, 0.0), translation(10.0, 0.0, 0.0));
+        world.addObject(std::move(sphere));
+        world.addObject(std::make_unique<Sphere>());
+        if (accelerated) {
+            world.buildBVH(1);
+            world.compile();
+        }
+        
+        //the static sphere is at the origin, the moving one ends the shutter ten units along
+        auto hits = world.intersects(Ray(create_point(10.0, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 1.0));
+        ASSERT_EQ(hits.size(), 2);
+        EXPECT_EQ(hits[0].time, 1.0);
+        
+        auto values = world.hitValuesAt(Ray(create_point(5.5, 0.0, -5.0), create_vector(0.0, 0.0, 1.0), 0.5));
+        ASSERT_TRUE(values);
+        EXPECT_EQ(values->normal, create_vector(0.5, 0.0, -std::sqrt(0.75)));
+        
+        EXPECT_TRUE(world.isOccluded(create_point(5.0, 0.0, -5.0), create_point(5.0, 0.0, 5.0), 0.5));
+        EXPECT_FALSE(world.isOccluded(create_point(5.0, 0.0, -5.0), create_point(5.0, 0.0, 5.0), 0.0));
+    }
+}
+
 }
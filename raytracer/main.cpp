@@ -5,11 +5,15 @@
 //  Created by Daniel Burke on 18/12/2022.
 //
 
+#include "accumulation_buffer.hpp"
 #include "camera.hpp"
 #include "canvas.hpp"
+#include "integrator.hpp"
 #include "plane.hpp"
+#include "region.hpp"
 #include "sphere.hpp"
 #include "transformations.hpp"
+#include "wavefront_integrator.hpp"
 #include "world.hpp"
 
 #include "oneapi/tbb.h"
@@ -80,6 +84,9 @@ std::unique_ptr<World> createWorld() {
     auto light = std::make_unique<Light>(create_point(-10, 10, -10), Colour(1.0, 1.0, 1.0));
     world->addLight(std::move(light));
     
+    world->buildBVH(4, BVHLayout::Wide);
+    world->compile();
+    
     return world;
 }
 
@@ -92,11 +99,15 @@ void runFuncTimed(std::function<void(void)> func) {
     std::cout << "Ray tracer duration: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << std::endl;
 }
 
+//anything dimmer than one step of an 8 bit channel can't change the output
+const double minContribution = 1.0 / 255.0;
+
 void renderSingleThreaded(Canvas& canvas, const Camera& camera, const World& world) {
+    Integrator integrator(world, minContribution);
     for (unsigned int x = 0; x < canvas.width(); x++) {
         for (unsigned int y = 0; y < canvas.height(); y++) {
             auto ray = camera.rayForPixel(x, y);
-            auto colour = world.colourAt(ray);
+            auto colour = integrator.colourAt(ray);
             canvas.writePixel(x, y, colour);
         }
     }
@@ -111,6 +122,8 @@ struct ScanLine {
 
 void renderMultiThreaded(Canvas& canvas, const Camera& camera, const World& world) {
     unsigned int y = 0;
+    //scanned once rather than per chunk, each chunk still needs its own integrator
+    auto features = world.features();
     
     oneapi::tbb::parallel_pipeline(6,
         oneapi::tbb::make_filter<void, ScanLine>(oneapi::tbb::filter_mode::serial_in_order, [&y, &canvas, &camera, &world] (oneapi::tbb::flow_control& fc) -> ScanLine {
@@ -126,12 +139,13 @@ void renderMultiThreaded(Canvas& canvas, const Camera& camera, const World& worl
             fc.stop();
             return ScanLine();
         }) &
-        oneapi::tbb::make_filter<ScanLine, ScanLine>(oneapi::tbb::filter_mode::parallel, [&canvas, &camera, &world] (ScanLine s) -> ScanLine {
+        oneapi::tbb::make_filter<ScanLine, ScanLine>(oneapi::tbb::filter_mode::parallel, [&canvas, &camera, &world, &features] (ScanLine s) -> ScanLine {
             auto start = std::chrono::high_resolution_clock::now();
+            Integrator integrator(world, features, minContribution);
             for (unsigned int y = s.yStart; y < s.yEnd; y++) {
                 for (unsigned int x = 0; x < s.width; x++) {
                     auto ray = camera.rayForPixel(x, y);
-                    auto colour = world.colourAt(ray);
+                    auto colour = integrator.colourAt(ray);
                     canvas.writePixel(x, y, colour);
                 }
             }
@@ -144,6 +158,35 @@ void renderMultiThreaded(Canvas& canvas, const Camera& camera, const World& worl
         }));
 }
 
+void renderRegion(Canvas& canvas, const Camera& camera, const World& world, const std::vector<PixelRect>& rects) {
+    Integrator integrator(world, minContribution);
+    RegionRenderer renderer(camera);
+    auto rendered = renderer.render(canvas, rects, [&integrator] (const Ray& ray) {
+        return integrator.colourAt(ray);
+    });
+    
+    std::cout << "Region pixels: " << rendered << std::endl;
+}
+
+void renderWavefront(Canvas& canvas, const Camera& camera, const World& world) {
+    WavefrontIntegrator integrator(world);
+    integrator.setParallelFor([] (unsigned int size, const WavefrontIntegrator::Kernel& kernel) {
+        oneapi::tbb::parallel_for(oneapi::tbb::blocked_range<unsigned int>(0, size, 1024), [&kernel] (const oneapi::tbb::blocked_range<unsigned int>& range) {
+            kernel(range.begin(), range.end());
+        });
+    });
+    
+    AccumulationBuffer buffer(canvas.width(), canvas.height());
+    integrator.accumulate(camera, buffer, 4);
+    buffer.resolve(canvas);
+    
+    const auto& timings = integrator.timings();
+    auto ms = [] (std::chrono::nanoseconds time) { return std::chrono::duration_cast<std::chrono::milliseconds>(time).count(); };
+    std::cout << "Stages generate: " << ms(timings.generate) << " extend: " << ms(timings.extend) << " material: " << ms(timings.material)
+              << " shadow: " << ms(timings.shadow) << " accumulate: " << ms(timings.accumulate) << std::endl;
+    std::cout << "Extension rays: " << timings.extensionRays << " shadow rays: " << timings.shadowRays << std::endl;
+}
+
 }
 
 int main(int argc, const char * argv[]) {
@@ -163,6 +206,17 @@ int main(int argc, const char * argv[]) {
         renderMultiThreaded(canvas, camera, *world);
     });
     
+    std::cout << "Region" << std::endl;
+    runFuncTimed([&] () {
+        renderRegion(canvas, camera, *world, {{400, 150, 200, 200}});
+    });
+    
+    auto pathTraced = Canvas(canvas.width(), canvas.height());
+    std::cout << "Wavefront path tracing" << std::endl;
+    runFuncTimed([&] () {
+        renderWavefront(pathTraced, camera, *world);
+    });
+    
     std::ofstream file;
     file.open("/tmp/out.ppm");
     